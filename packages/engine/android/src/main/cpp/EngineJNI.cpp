@@ -24,6 +24,18 @@ static engine::Engine* g_engine = nullptr;
 static std::vector<engine::Engine::FrameResult> g_resultBuffer;
 static std::mutex g_engineMutex;
 
+// Zero-copy audio path: the Java side registers a pair of direct ByteBuffers
+// once, we resolve their addresses here, and nativeProcessAudioDirect then
+// runs with no per-call marshalling at all. Guarded by g_engineMutex.
+static float* g_directAudio = nullptr;
+static jint g_directAudioCapacity = 0;     // in floats
+static engine::Engine::FrameResult* g_directResults = nullptr;
+static jint g_directResultCapacity = 0;    // in FrameResult slots
+
+// The results buffer is reinterpreted as packed (beat, downbeat) float pairs
+static_assert(sizeof(engine::Engine::FrameResult) == 2 * sizeof(float),
+              "FrameResult must stay two packed floats for the direct path");
+
 extern "C" {
 
 // ============================================================================
@@ -201,7 +213,70 @@ Java_services_session_keyed_engine_EngineModule_nativeGetKeyFrameCount(JNIEnv* e
 }
 
 // ============================================================================
-// Audio Processing
+// Audio Processing - zero-copy path
+// ============================================================================
+
+/**
+ * Register direct ByteBuffers for the zero-copy audio path.
+ * audio carries input samples, results receives (beat, downbeat) float pairs.
+ * Pass null to unregister. Returns false when either buffer is not a direct
+ * buffer - the caller should fall back to nativeProcessAudio.
+ */
+JNIEXPORT jboolean JNICALL
+Java_services_session_keyed_engine_EngineModule_nativeRegisterBuffers(
+	JNIEnv* env, jobject thiz, jobject audio, jobject results) {
+
+	std::lock_guard<std::mutex> lock(g_engineMutex);
+	g_directAudio = nullptr;
+	g_directAudioCapacity = 0;
+	g_directResults = nullptr;
+	g_directResultCapacity = 0;
+
+	if (audio == nullptr || results == nullptr) {
+		return JNI_TRUE;  // Unregistered
+	}
+
+	void* audioAddr = env->GetDirectBufferAddress(audio);
+	jlong audioBytes = env->GetDirectBufferCapacity(audio);
+	void* resultAddr = env->GetDirectBufferAddress(results);
+	jlong resultBytes = env->GetDirectBufferCapacity(results);
+
+	if (!audioAddr || audioBytes <= 0 || !resultAddr ||
+	    resultBytes < static_cast<jlong>(sizeof(engine::Engine::FrameResult))) {
+		LOGE("registerBuffers: not direct buffers, use the array path");
+		return JNI_FALSE;
+	}
+
+	g_directAudio = static_cast<float*>(audioAddr);
+	g_directAudioCapacity = static_cast<jint>(audioBytes / sizeof(float));
+	g_directResults = static_cast<engine::Engine::FrameResult*>(resultAddr);
+	g_directResultCapacity = static_cast<jint>(resultBytes / sizeof(engine::Engine::FrameResult));
+	LOGI("Direct buffers registered: %d samples in, %d results out",
+	     g_directAudioCapacity, g_directResultCapacity);
+	return JNI_TRUE;
+}
+
+/**
+ * Process count samples already written into the registered audio buffer.
+ * Results land in the registered results buffer as (beat, downbeat) pairs.
+ * Returns the number of result frames, or -1 when no buffers are registered.
+ */
+JNIEXPORT jint JNICALL
+Java_services_session_keyed_engine_EngineModule_nativeProcessAudioDirect(
+	JNIEnv* env, jobject thiz, jint count) {
+
+	std::lock_guard<std::mutex> lock(g_engineMutex);
+	if (!g_engine || !g_directAudio || !g_directResults) {
+		return -1;
+	}
+
+	const int validSamples = std::max(0, std::min(count, g_directAudioCapacity));
+	return g_engine->processAudio(g_directAudio, validSamples,
+	                              g_directResults, g_directResultCapacity);
+}
+
+// ============================================================================
+// Audio Processing - array fallback
 // ============================================================================
 
 JNIEXPORT jobjectArray JNICALL
@@ -210,7 +285,14 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudio(
 
 	jsize numSamples = env->GetArrayLength(samples);
 	const int validSamples = std::max(0, std::min(static_cast<int>(numSamples), static_cast<int>(count)));
-	jfloat* sampleData = env->GetFloatArrayElements(samples, nullptr);
+
+	// Pin the array instead of copying it; safe because nothing below makes
+	// JNI calls until the array is released (GC stays paused meanwhile, which
+	// is fine for a ~20ms chunk)
+	jfloat* sampleData = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(samples, nullptr));
+	if (sampleData == nullptr) {
+		return nullptr;
+	}
 
 	int numResults = 0;
 	std::vector<engine::Engine::FrameResult> localResults;
@@ -218,7 +300,7 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudio(
 	{
 		std::lock_guard<std::mutex> lock(g_engineMutex);
 		if (!g_engine) {
-			env->ReleaseFloatArrayElements(samples, sampleData, 0);
+			env->ReleasePrimitiveArrayCritical(samples, sampleData, JNI_ABORT);
 			return nullptr;
 		}
 
@@ -232,7 +314,8 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudio(
 		}
 	}
 
-	env->ReleaseFloatArrayElements(samples, sampleData, 0);
+	// Input-only array - JNI_ABORT skips writing anything back
+	env->ReleasePrimitiveArrayCritical(samples, sampleData, JNI_ABORT);
 
 	if (numResults == 0) {
 		return nullptr;
@@ -274,7 +357,11 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudioForBpm(
 	JNIEnv* env, jobject thiz, jfloatArray samples) {
 
 	jsize numSamples = env->GetArrayLength(samples);
-	jfloat* sampleData = env->GetFloatArrayElements(samples, nullptr);
+
+	jfloat* sampleData = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(samples, nullptr));
+	if (sampleData == nullptr) {
+		return nullptr;
+	}
 
 	int numResults = 0;
 	std::vector<engine::Engine::FrameResult> localResults;
@@ -282,7 +369,7 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudioForBpm(
 	{
 		std::lock_guard<std::mutex> lock(g_engineMutex);
 		if (!g_engine || !g_engine->isReady()) {
-			env->ReleaseFloatArrayElements(samples, sampleData, 0);
+			env->ReleasePrimitiveArrayCritical(samples, sampleData, JNI_ABORT);
 			return nullptr;
 		}
 
@@ -295,7 +382,7 @@ Java_services_session_keyed_engine_EngineModule_nativeProcessAudioForBpm(
 		}
 	}
 
-	env->ReleaseFloatArrayElements(samples, sampleData, 0);
+	env->ReleasePrimitiveArrayCritical(samples, sampleData, JNI_ABORT);
 
 	if (numResults == 0) {
 		return nullptr;
@@ -13,6 +13,8 @@ import expo.modules.kotlin.modules.ModuleDefinition
 import expo.modules.interfaces.permissions.PermissionsStatus
 import java.io.File
 import java.io.FileOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 import java.util.concurrent.atomic.AtomicBoolean
 import kotlin.concurrent.thread
 import kotlin.math.abs
@@ -41,6 +43,8 @@ class EngineModule : Module() {
 	private external fun nativeWarmUp(): Boolean
 	private external fun nativeProcessAudio(samples: FloatArray, count: Int): Array<FrameResult>?
 	private external fun nativeProcessAudioForBpm(samples: FloatArray): Array<FrameResult>?
+	private external fun nativeRegisterBuffers(audio: ByteBuffer?, results: ByteBuffer?): Boolean
+	private external fun nativeProcessAudioDirect(count: Int): Int
 	private external fun nativeGetBpm(): Float
 	private external fun nativeGetFrameCount(): Long
 
@@ -295,21 +299,51 @@ class EngineModule : Module() {
 
 		recordingThread = thread(start = true) {
 			val buffer = FloatArray(882)  // ~20ms at 44100Hz
+			// Zero-copy path: AudioRecord writes into a registered direct
+			// buffer the native side processes in place. Falls back to the
+			// FloatArray path when registration fails.
+			val audio = ByteBuffer.allocateDirect(buffer.size * 4).order(ByteOrder.nativeOrder())
+			val results = ByteBuffer.allocateDirect(200 * 2 * 4).order(ByteOrder.nativeOrder())
+			val direct = nativeRegisterBuffers(audio, results) && audio.isDirect
+			val resultFloats = results.asFloatBuffer()
+			val audioFloats = audio.asFloatBuffer()
+
 			while (isRecordingAudio.get()) {
 				val recorder = audioRecord ?: break
 				val read = try {
-					recorder.read(buffer, 0, buffer.size, AudioRecord.READ_BLOCKING)
+					if (direct) {
+						audio.clear()
+						val bytes = recorder.read(audio, audio.capacity(), AudioRecord.READ_BLOCKING)
+						if (bytes >= 0) bytes / 4 else bytes
+					} else {
+						recorder.read(buffer, 0, buffer.size, AudioRecord.READ_BLOCKING)
+					}
 				} catch (e: IllegalStateException) {
 					Log.w(TAG, "AudioRecord.read() failed: ${e.message}", e)
 					break
 				}
 
 				if (read > 0 && isRecordingAudio.get()) {
-					processAudioSamples(buffer, read, enableWaveform)
+					if (direct) {
+						val produced = nativeProcessAudioDirect(read)
+						val beat = if (produced > 0) resultFloats.get((produced - 1) * 2) else null
+						val down = if (produced > 0) resultFloats.get((produced - 1) * 2 + 1) else null
+						if (enableWaveform) {
+							audioFloats.position(0)
+							audioFloats.get(buffer, 0, read)
+						}
+						emitUpdates(beat, down, buffer, read, enableWaveform)
+					} else {
+						processAudioSamples(buffer, read, enableWaveform)
+					}
 				} else if (read < 0) {
 					break
 				}
 			}
+
+			if (direct) {
+				nativeRegisterBuffers(null, null)
+			}
 		}
 
 		debugLog("Audio recording started at ${SAMPLE_RATE}Hz")
@@ -356,7 +390,11 @@ class EngineModule : Module() {
 	}
 
 	private fun processAudioSamples(samples: FloatArray, count: Int, enableWaveform: Boolean) {
-		val results = nativeProcessAudio(samples, count)
+		val last = nativeProcessAudio(samples, count)?.lastOrNull()
+		emitUpdates(last?.beatActivation, last?.downbeatActivation, samples, count, enableWaveform)
+	}
+
+	private fun emitUpdates(beat: Float?, down: Float?, samples: FloatArray, count: Int, enableWaveform: Boolean) {
 		val nowNs = System.nanoTime()
 		val timestampSeconds = if (recordingStartTimeNs > 0L) {
 			(nowNs - recordingStartTimeNs).toDouble() / 1_000_000_000.0
@@ -364,19 +402,16 @@ class EngineModule : Module() {
 			0.0
 		}
 
-		if (results != null && nowNs - lastStateEmitNs >= STATE_EMIT_INTERVAL_NS) {
-			val result = results.lastOrNull()
-			if (result != null) {
-				lastStateEmitNs = nowNs
-				sendEvent(
-					"onState",
-					mapOf(
-						"beatActivation" to result.beatActivation.toDouble(),
-						"downbeatActivation" to result.downbeatActivation.toDouble(),
-						"timestamp" to timestampSeconds
-					)
+		if (beat != null && down != null && nowNs - lastStateEmitNs >= STATE_EMIT_INTERVAL_NS) {
+			lastStateEmitNs = nowNs
+			sendEvent(
+				"onState",
+				mapOf(
+					"beatActivation" to beat.toDouble(),
+					"downbeatActivation" to down.toDouble(),
+					"timestamp" to timestampSeconds
 				)
-			}
+			)
 		}
 
 		// Check for key detection updates (emit on key change OR significant confidence change)
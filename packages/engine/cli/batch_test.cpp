@@ -8,11 +8,15 @@
 #include "miniaudio.h"
 
 #include "Engine.hpp"
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <dirent.h>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -73,6 +77,60 @@ std::map<std::string, std::string> getExpectedKeys() {
 	};
 }
 
+// Processing chunk size (882 samples = 20ms at 44100Hz)
+constexpr int CHUNK_SIZE = 882;
+
+/**
+ * Bounded PCM chunk queue between the decode and analysis threads
+ *
+ * The decoder runs ahead of analysis by up to CAPACITY chunks, so codec
+ * time (notably MP3/AAC) hides entirely behind DSP time instead of
+ * serializing with it. Blocking push keeps the decoder from racing the
+ * whole file into memory; blocking pop keeps analysis fed.
+ */
+struct ChunkQueue {
+	static constexpr size_t CAPACITY = 64;
+
+	struct Chunk {
+		float samples[CHUNK_SIZE];
+		int count;
+	};
+
+	void push(const Chunk& chunk) {
+		std::unique_lock<std::mutex> lock(mutex);
+		canPush.wait(lock, [this] { return chunks.size() < CAPACITY; });
+		chunks.push_back(chunk);
+		canPop.notify_one();
+	}
+
+	// False once the decoder has finished and the queue is drained
+	bool pop(Chunk& chunk) {
+		std::unique_lock<std::mutex> lock(mutex);
+		canPop.wait(lock, [this] { return !chunks.empty() || done; });
+		if (chunks.empty()) {
+			return false;
+		}
+		chunk = chunks.front();
+		chunks.pop_front();
+		canPush.notify_one();
+		return true;
+	}
+
+	void finish() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+		}
+		canPop.notify_all();
+	}
+
+	std::deque<Chunk> chunks;
+	std::mutex mutex;
+	std::condition_variable canPush;
+	std::condition_variable canPop;
+	bool done = false;
+};
+
 struct TestResult {
 	std::string filename;
 	float expectedBpm;
@@ -147,18 +205,28 @@ TestResult testFile(const std::string& filepath, Engine& engine,
 	// Reset engine state
 	engine.reset();
 
-	// Process audio in chunks (882 samples = 20ms at 44100Hz)
-	constexpr int CHUNK_SIZE = 882;
-	float buffer[CHUNK_SIZE];
+	// Overlapped decode/analyze: the decoder fills the bounded queue while
+	// this thread drains it through the engine
+	ChunkQueue queue;
+	std::thread decodeThread([&decoder, &queue] {
+		ChunkQueue::Chunk chunk;
+		ma_uint64 framesRead;
+		while (ma_decoder_read_pcm_frames(&decoder, chunk.samples, CHUNK_SIZE,
+		                                  &framesRead) == MA_SUCCESS && framesRead > 0) {
+			chunk.count = static_cast<int>(framesRead);
+			queue.push(chunk);
+		}
+		queue.finish();
+	});
+
 	static constexpr int MAX_RESULTS = 16;
 	Engine::FrameResult results[MAX_RESULTS];
-
-	ma_uint64 framesRead;
-
-	while (ma_decoder_read_pcm_frames(&decoder, buffer, CHUNK_SIZE, &framesRead) == MA_SUCCESS && framesRead > 0) {
-		engine.processAudio(buffer, static_cast<int>(framesRead), results, MAX_RESULTS);
+	ChunkQueue::Chunk chunk;
+	while (queue.pop(chunk)) {
+		engine.processAudio(chunk.samples, chunk.count, results, MAX_RESULTS);
 	}
 
+	decodeThread.join();
 	ma_decoder_uninit(&decoder);
 
 	// Get BPM results
@@ -1,9 +1,13 @@
 #pragma once
 
-#include "pocketfft_hdronly.h"
+#include "CombTempo.hpp"
+#include "FFT.hpp"
+#include "MirroredRing.hpp"
+#include "StateBlob.hpp"
 #include <vector>
 #include <cmath>
 #include <complex>
+#include <memory>
 #include <algorithm>
 
 namespace engine {
@@ -22,6 +26,14 @@ namespace engine {
  * 3. Find peak in valid tempo range (60-180 BPM)
  * 4. Refine with parabolic interpolation
  * 5. Convert lag to BPM: bpm = 60 * fps / peak_lag
+ *
+ * The estimator is stateful: it builds its FFT plan and work buffers once
+ * for a fixed window size, so the periodic recompute during streaming does
+ * no allocation and no redundant plan setup. The input is real, so the
+ * transforms run through the shared real-input FFT backend (half the work
+ * of a complex transform), the same one MelExtractor's STFT uses. For
+ * one-shot use the static estimate() wrapper constructs a throwaway
+ * instance.
  */
 class AutocorrBpmEstimator {
 public:
@@ -33,35 +45,68 @@ public:
 	static constexpr float DJ_MIN_BPM = 75.0f;
 	static constexpr float DJ_MAX_BPM = 165.0f;
 
+	/**
+	 * @param maxFrames Largest window compute() will be called with.
+	 *                  The FFT plan and scratch are sized for this once.
+	 */
+	explicit AutocorrBpmEstimator(size_t maxFrames = 512)
+		: maxFrames_(maxFrames),
+		  fftSize_(fftSizeFor(maxFrames)),
+		  fft_(std::make_unique<FFT>(fftSize_)) {
+		work_.resize(fftSize_, 0.0f);
+		spectrum_.resize(fftSize_ / 2 + 1);
+	}
+
 	/**
 	 * Estimate BPM from neural network activations using autocorrelation.
+	 * Allocation-free for numFrames <= maxFrames (grows the plan otherwise).
 	 *
 	 * @param beatActivations Beat activation probabilities (one per frame)
 	 * @param downbeatActivations Downbeat activation probabilities (one per frame)
 	 * @param numFrames Number of frames in the arrays
 	 * @param applyOctaveCorrection If true, correct half/double time for DJ range
+	 * @param fps Frame rate of the activations (decimated tiers pass a lower rate)
 	 * @return Estimated BPM (rounded to integer), or 0 if insufficient data
 	 */
-	static float estimate(const float* beatActivations,
-	                      const float* downbeatActivations,
-	                      size_t numFrames,
-	                      bool applyOctaveCorrection = true) {
-		if (numFrames < static_cast<size_t>(FPS)) {
+	float compute(const float* beatActivations,
+	              const float* downbeatActivations,
+	              size_t numFrames,
+	              bool applyOctaveCorrection = true,
+	              float fps = FPS) {
+		if (numFrames < static_cast<size_t>(fps)) {
 			return 0.0f;
 		}
 
-		// Sum beat + downbeat activations
-		std::vector<float> signal(numFrames);
-		for (size_t i = 0; i < numFrames; i++) {
-			signal[i] = beatActivations[i] + downbeatActivations[i];
+		if (numFrames > maxFrames_) {
+			maxFrames_ = numFrames;
+			fftSize_ = fftSizeFor(numFrames);
+			fft_ = std::make_unique<FFT>(fftSize_);
+			work_.resize(fftSize_);
+			spectrum_.resize(fftSize_ / 2 + 1);
 		}
 
-		// Compute autocorrelation using FFT
-		std::vector<float> autocorr = computeAutocorrelationFFT(signal);
+		// Sum beat + downbeat activations, zero-padded to fftSize for
+		// linear (non-circular) autocorrelation
+		for (size_t i = 0; i < numFrames; i++) {
+			work_[i] = beatActivations[i] + downbeatActivations[i];
+		}
+		std::fill(work_.begin() + numFrames, work_.end(), 0.0f);
+
+		// Autocorrelation via the shared real FFT backend: forward, power
+		// spectrum (multiply by conjugate), inverse back into the work buffer
+		fft_->forward(work_.data(), spectrum_.data());
+		const size_t bins = fftSize_ / 2 + 1;
+		for (size_t k = 0; k < bins; k++) {
+			float re = spectrum_[k].real();
+			float im = spectrum_[k].imag();
+			spectrum_[k] = {re * re + im * im, 0.0f};
+		}
+		fft_->inverse(spectrum_.data(), work_.data());
 
-		// Valid tempo range lags
-		int minLag = static_cast<int>(FPS * 60.0f / MAX_BPM);  // ~17 frames (180 BPM)
-		int maxLag = static_cast<int>(FPS * 60.0f / MIN_BPM);  // 50 frames (60 BPM)
+		// Valid tempo range lags (normalization is a positive scale, so the
+		// peak search and interpolation run on the raw autocorrelation)
+		int minLag = static_cast<int>(fps * 60.0f / MAX_BPM);  // ~17 frames at 50 FPS (180 BPM)
+		int maxLag = static_cast<int>(fps * 60.0f / MIN_BPM);  // 50 frames at 50 FPS (60 BPM)
 
 		if (maxLag >= static_cast<int>(numFrames)) {
 			maxLag = static_cast<int>(numFrames) - 1;
@@ -72,10 +117,10 @@ public:
 
 		// Find peak in valid range
 		int peakIdx = minLag;
-		float peakVal = autocorr[minLag];
+		float peakVal = work_[minLag];
 		for (int i = minLag + 1; i < maxLag; i++) {
-			if (autocorr[i] > peakVal) {
-				peakVal = autocorr[i];
+			if (work_[i] > peakVal) {
+				peakVal = work_[i];
 				peakIdx = i;
 			}
 		}
@@ -83,9 +128,9 @@ public:
 		// Refine with parabolic interpolation
 		float refinedPeakIdx = static_cast<float>(peakIdx);
 		if (peakIdx > 0 && peakIdx < static_cast<int>(numFrames) - 1) {
-			float y0 = autocorr[peakIdx - 1];
-			float y1 = autocorr[peakIdx];
-			float y2 = autocorr[peakIdx + 1];
+			float y0 = work_[peakIdx - 1];
+			float y1 = work_[peakIdx];
+			float y2 = work_[peakIdx + 1];
 			if (y1 > y0 && y1 > y2) {  // Valid peak
 				float denom = y0 - 2.0f * y1 + y2;
 				if (std::fabs(denom) > 1e-8f) {
@@ -96,108 +141,135 @@ public:
 		}
 
 		// Convert lag to BPM
-		float bpm = 60.0f * FPS / refinedPeakIdx;
+		float bpm = 60.0f * fps / refinedPeakIdx;
 		bpm = std::round(bpm);
 
-		// Apply octave correction for DJ range
-		if (applyOctaveCorrection && bpm > 0) {
-			float doubled = bpm * 2.0f;
-			float halved = bpm / 2.0f;
-
-			if (bpm < DJ_MIN_BPM && doubled >= DJ_MIN_BPM && doubled <= DJ_MAX_BPM) {
-				bpm = doubled;
-			} else if (bpm > DJ_MAX_BPM && halved >= DJ_MIN_BPM && halved <= DJ_MAX_BPM) {
-				bpm = halved;
-			}
+		if (applyOctaveCorrection) {
+			bpm = correctOctave(bpm);
 		}
 
 		return bpm;
 	}
 
-private:
 	/**
-	 * Compute autocorrelation using FFT method - O(n log n)
-	 * autocorr[k] = sum_i(signal[i] * signal[i+k])
-	 *
-	 * Uses pocketfft for efficient computation.
+	 * One-shot convenience wrapper around compute(). Builds a throwaway
+	 * estimator, so streaming callers should hold an instance instead.
 	 */
-	static std::vector<float> computeAutocorrelationFFT(const std::vector<float>& signal) {
-		size_t n = signal.size();
-
-		// FFT size should be power of 2 and at least 2*n for linear (non-circular) autocorr
-		size_t fftSize = 1;
-		while (fftSize < 2 * n) fftSize *= 2;
-
-		// Zero-pad signal into complex buffer
-		std::vector<std::complex<float>> padded(fftSize, {0.0f, 0.0f});
-		for (size_t i = 0; i < n; i++) {
-			padded[i] = {signal[i], 0.0f};
+	static float estimate(const float* beatActivations,
+	                      const float* downbeatActivations,
+	                      size_t numFrames,
+	                      bool applyOctaveCorrection = true,
+	                      float fps = FPS) {
+		if (numFrames < static_cast<size_t>(fps)) {
+			return 0.0f;
 		}
+		AutocorrBpmEstimator estimator(numFrames);
+		return estimator.compute(beatActivations, downbeatActivations,
+		                         numFrames, applyOctaveCorrection, fps);
+	}
 
-		// Setup pocketfft parameters
-		pocketfft::shape_t shape = {fftSize};
-		pocketfft::stride_t stride = {sizeof(std::complex<float>)};
-		pocketfft::shape_t axes = {0};
-
-		// Forward FFT (in-place)
-		std::vector<std::complex<float>> spectrum(fftSize);
-		pocketfft::c2c(shape, stride, stride, axes, pocketfft::FORWARD,
-		               padded.data(), spectrum.data(), 1.0f);
-
-		// Power spectrum (multiply by conjugate)
-		for (size_t k = 0; k < fftSize; k++) {
-			float re = spectrum[k].real();
-			float im = spectrum[k].imag();
-			spectrum[k] = {re * re + im * im, 0.0f};
+	/**
+	 * Correct half/double time into the DJ range.
+	 */
+	static float correctOctave(float bpm) {
+		if (bpm <= 0) {
+			return bpm;
 		}
+		float doubled = bpm * 2.0f;
+		float halved = bpm / 2.0f;
 
-		// Inverse FFT
-		std::vector<std::complex<float>> ifftResult(fftSize);
-		pocketfft::c2c(shape, stride, stride, axes, pocketfft::BACKWARD,
-		               spectrum.data(), ifftResult.data(), 1.0f / fftSize);
-
-		// Extract real part and normalize
-		std::vector<float> autocorr(n);
-		float norm = ifftResult[0].real() + 1e-8f;
-		for (size_t i = 0; i < n; i++) {
-			autocorr[i] = ifftResult[i].real() / norm;
+		if (bpm < DJ_MIN_BPM && doubled >= DJ_MIN_BPM && doubled <= DJ_MAX_BPM) {
+			return doubled;
+		}
+		if (bpm > DJ_MAX_BPM && halved >= DJ_MIN_BPM && halved <= DJ_MAX_BPM) {
+			return halved;
 		}
+		return bpm;
+	}
 
-		return autocorr;
+private:
+	// FFT size: power of 2 and at least 2*n for linear (non-circular) autocorr
+	static size_t fftSizeFor(size_t numFrames) {
+		size_t fftSize = 1;
+		while (fftSize < 2 * numFrames) fftSize *= 2;
+		return fftSize;
 	}
+
+	size_t maxFrames_;
+	size_t fftSize_;
+	std::unique_ptr<FFT> fft_;
+	std::vector<float> work_;                     // Signal in, autocorr out
+	std::vector<std::complex<float>> spectrum_;   // Forward output / power
 };
 
 /**
  * Circular buffer to collect activations for autocorrelation BPM estimation.
- * Uses a ring buffer for O(1) push operations.
+ * Uses double-mapped ring buffers for O(1) push operations whose windows
+ * read as contiguous pointers, so estimates need no copy-out.
+ *
+ * Holds two tiers: the full-rate ring (~10s at 50 FPS) and a 4:1 decimated
+ * ring covering four times the span at 12.5 FPS. The short tier stays
+ * responsive; the long tier sees enough context to pin down the octave on
+ * steady tracks, so estimates cross-check the short peak against the long
+ * one and snap to the octave the long window supports.
  *
- * Also caches BPM computation to avoid redundant calculations.
+ * Also caches BPM computation to avoid redundant calculations. The owned
+ * estimator and linearization scratch are sized once, so the periodic
+ * recompute is allocation-free.
  */
 class ActivationBuffer {
 public:
 	static constexpr size_t DEFAULT_MAX_FRAMES = 512;  // ~10 seconds at 50 FPS
 	static constexpr size_t MIN_FRAMES_FOR_BPM = 100;  // ~2 seconds
 
+	// Decimated tier: 4 frames averaged into 1, same ring length, so the
+	// long-window FFT costs the same as the short one at a quarter the rate
+	static constexpr size_t DECIMATION = 4;
+
 	explicit ActivationBuffer(size_t maxFrames = DEFAULT_MAX_FRAMES)
 		: maxFrames_(maxFrames),
 		  head_(0),
 		  count_(0),
+		  beatRing_(maxFrames),
+		  downbeatRing_(maxFrames),
+		  decimatedBeatRing_(maxFrames),
+		  decimatedDownbeatRing_(maxFrames),
+		  estimator_(maxFrames),
 		  cachedBpm_(0.0f),
 		  framesSinceLastCompute_(0),
 		  bpmComputeInterval_(25) {  // Recompute every 25 frames (~500ms)
-		beatActivations_.resize(maxFrames, 0.0f);
-		downbeatActivations_.resize(maxFrames, 0.0f);
 	}
 
 	void push(float beatActivation, float downbeatActivation) {
-		beatActivations_[head_] = beatActivation;
-		downbeatActivations_[head_] = downbeatActivation;
-		head_ = (head_ + 1) % maxFrames_;
+		// Ring positions run modulo the mapped capacity (page-rounded, may
+		// exceed maxFrames); count_ still caps the window at maxFrames
+		beatRing_.store(head_, &beatActivation, 1);
+		downbeatRing_.store(head_, &downbeatActivation, 1);
+		combTracker_.push(beatActivation + downbeatActivation);
+		head_ = (head_ + 1) % beatRing_.capacity();
 		if (count_ < maxFrames_) {
 			count_++;
 		}
 		framesSinceLastCompute_++;
 
+		// Accumulate into the decimated tier
+		pendingBeat_ += beatActivation;
+		pendingDownbeat_ += downbeatActivation;
+		pendingFrames_++;
+		if (pendingFrames_ == DECIMATION) {
+			float beatMean = pendingBeat_ / DECIMATION;
+			float downbeatMean = pendingDownbeat_ / DECIMATION;
+			decimatedBeatRing_.store(decimatedHead_, &beatMean, 1);
+			decimatedDownbeatRing_.store(decimatedHead_, &downbeatMean, 1);
+			decimatedHead_ = (decimatedHead_ + 1) % decimatedBeatRing_.capacity();
+			if (decimatedCount_ < maxFrames_) {
+				decimatedCount_++;
+			}
+			pendingBeat_ = 0.0f;
+			pendingDownbeat_ = 0.0f;
+			pendingFrames_ = 0;
+		}
+
 		// Auto-compute BPM periodically if we have enough frames
 		if (count_ >= MIN_FRAMES_FOR_BPM &&
 		    framesSinceLastCompute_ >= bpmComputeInterval_) {
@@ -210,6 +282,12 @@ public:
 		count_ = 0;
 		cachedBpm_ = 0.0f;
 		framesSinceLastCompute_ = 0;
+		combTracker_.clear();
+		decimatedHead_ = 0;
+		decimatedCount_ = 0;
+		pendingBeat_ = 0.0f;
+		pendingDownbeat_ = 0.0f;
+		pendingFrames_ = 0;
 	}
 
 	size_t size() const {
@@ -224,6 +302,80 @@ public:
 		return cachedBpm_;
 	}
 
+	/**
+	 * Read the incremental comb-filterbank tempo estimate.
+	 * Unlike the cached autocorrelation BPM this is always current: the bank
+	 * is updated on every push() at constant cost, so reading it here does
+	 * no transform work. Returns 0 if insufficient data.
+	 */
+	float estimateCombBpm(bool applyOctaveCorrection = true) const {
+		return combTracker_.estimate(applyOctaveCorrection);
+	}
+
+	/**
+	 * Serialize both ring tiers, counters and the comb tracker for Engine
+	 * snapshots. The estimator's scratch is rebuilt on the next compute.
+	 */
+	void saveState(StateWriter& w) const {
+		w.write(static_cast<uint64_t>(head_));
+		w.write(static_cast<uint64_t>(count_));
+		w.write(static_cast<uint64_t>(beatRing_.capacity()));
+		w.writeFloats(beatRing_.window(0), beatRing_.capacity());
+		w.writeFloats(downbeatRing_.window(0), downbeatRing_.capacity());
+		w.writeFloats(decimatedBeatRing_.window(0), decimatedBeatRing_.capacity());
+		w.writeFloats(decimatedDownbeatRing_.window(0), decimatedDownbeatRing_.capacity());
+		w.write(static_cast<uint64_t>(decimatedHead_));
+		w.write(static_cast<uint64_t>(decimatedCount_));
+		w.write(pendingBeat_);
+		w.write(pendingDownbeat_);
+		w.write(static_cast<uint64_t>(pendingFrames_));
+		w.write(cachedBpm_);
+		w.write(static_cast<uint64_t>(framesSinceLastCompute_));
+		combTracker_.saveState(w);
+	}
+
+	/** Restore a snapshot; ring capacities must match this build's layout */
+	bool loadState(StateReader& r) {
+		uint64_t head = 0;
+		uint64_t count = 0;
+		if (!r.read(head) || !r.read(count) ||
+		    !r.expect(static_cast<uint64_t>(beatRing_.capacity())) ||
+		    head >= beatRing_.capacity() || count > maxFrames_) {
+			return false;
+		}
+
+		// All four rings share one capacity (sized from the same maxFrames)
+		std::vector<float> ring(beatRing_.capacity());
+		MirroredRing* rings[] = {&beatRing_, &downbeatRing_,
+		                         &decimatedBeatRing_, &decimatedDownbeatRing_};
+		for (MirroredRing* target : rings) {
+			if (!r.readFloats(ring.data(), ring.size())) {
+				return false;
+			}
+			target->store(0, ring.data(), ring.size());
+		}
+
+		uint64_t decimatedHead = 0;
+		uint64_t decimatedCount = 0;
+		uint64_t pendingFrames = 0;
+		uint64_t sinceCompute = 0;
+		if (!r.read(decimatedHead) || !r.read(decimatedCount) ||
+		    decimatedHead >= decimatedBeatRing_.capacity() || decimatedCount > maxFrames_ ||
+		    !r.read(pendingBeat_) || !r.read(pendingDownbeat_) ||
+		    !r.read(pendingFrames) || !r.read(cachedBpm_) || !r.read(sinceCompute) ||
+		    !combTracker_.loadState(r)) {
+			return false;
+		}
+
+		head_ = static_cast<size_t>(head);
+		count_ = static_cast<size_t>(count);
+		decimatedHead_ = static_cast<size_t>(decimatedHead);
+		decimatedCount_ = static_cast<size_t>(decimatedCount);
+		pendingFrames_ = static_cast<size_t>(pendingFrames);
+		framesSinceLastCompute_ = static_cast<size_t>(sinceCompute);
+		return true;
+	}
+
 	/**
 	 * Force recompute BPM (used when stopping recording).
 	 */
@@ -232,13 +384,7 @@ public:
 			return 0.0f;
 		}
 
-		// Extract activations in order (oldest to newest)
-		std::vector<float> beatActs(count_);
-		std::vector<float> downbeatActs(count_);
-		extractInOrder(beatActs.data(), downbeatActs.data());
-
-		cachedBpm_ = AutocorrBpmEstimator::estimate(
-			beatActs.data(), downbeatActs.data(), count_, applyOctaveCorrection);
+		cachedBpm_ = estimateTiered(applyOctaveCorrection);
 		framesSinceLastCompute_ = 0;
 
 		return cachedBpm_;
@@ -246,32 +392,85 @@ public:
 
 private:
 	void recomputeBpm() {
-		// Extract activations in order
-		std::vector<float> beatActs(count_);
-		std::vector<float> downbeatActs(count_);
-		extractInOrder(beatActs.data(), downbeatActs.data());
-
-		cachedBpm_ = AutocorrBpmEstimator::estimate(
-			beatActs.data(), downbeatActs.data(), count_, true);
+		cachedBpm_ = estimateTiered(true);
 		framesSinceLastCompute_ = 0;
 	}
 
-	void extractInOrder(float* beatOut, float* downbeatOut) const {
-		// Ring buffer: oldest is at (head_ - count_ + maxFrames_) % maxFrames_
-		// or simply: if count_ < maxFrames_, start at 0; else start at head_
-		size_t start = (count_ < maxFrames_) ? 0 : head_;
-		for (size_t i = 0; i < count_; i++) {
-			size_t idx = (start + i) % maxFrames_;
-			beatOut[i] = beatActivations_[idx];
-			downbeatOut[i] = downbeatActivations_[idx];
+	/**
+	 * Short-window estimate cross-checked against the decimated long window.
+	 * Both tiers run raw (no DJ correction); if the long tier supports a
+	 * different octave of the short peak, the short estimate snaps to it.
+	 * DJ-range correction is applied last.
+	 */
+	float estimateTiered(bool applyOctaveCorrection) {
+		// Oldest frame is count_ behind the head; the mirrored mapping makes
+		// the window contiguous from there, so both tiers read in place
+		size_t cap = beatRing_.capacity();
+		size_t start = (head_ + cap - count_) % cap;
+		float bpm = estimator_.compute(
+			beatRing_.window(start), downbeatRing_.window(start), count_, false);
+
+		if (decimatedCount_ >= MIN_FRAMES_FOR_BPM) {
+			size_t decimatedCap = decimatedBeatRing_.capacity();
+			size_t decimatedStart =
+				(decimatedHead_ + decimatedCap - decimatedCount_) % decimatedCap;
+			float longBpm = estimator_.compute(
+				decimatedBeatRing_.window(decimatedStart),
+				decimatedDownbeatRing_.window(decimatedStart), decimatedCount_,
+				false, AutocorrBpmEstimator::FPS / DECIMATION);
+			bpm = reconcileOctave(bpm, longBpm);
+		}
+
+		if (applyOctaveCorrection) {
+			bpm = AutocorrBpmEstimator::correctOctave(bpm);
+		}
+		return bpm;
+	}
+
+	/**
+	 * Pick the octave of the short-window estimate closest to the
+	 * long-window one. Non-octave disagreements keep the short estimate,
+	 * which tracks transitions faster.
+	 */
+	static float reconcileOctave(float shortBpm, float longBpm) {
+		if (shortBpm <= 0.0f) {
+			return longBpm;
+		}
+		if (longBpm <= 0.0f) {
+			return shortBpm;
+		}
+		float best = shortBpm;
+		for (float candidate : {shortBpm * 2.0f, shortBpm * 0.5f}) {
+			if (candidate >= AutocorrBpmEstimator::MIN_BPM &&
+			    candidate <= AutocorrBpmEstimator::MAX_BPM &&
+			    std::fabs(candidate - longBpm) < std::fabs(best - longBpm)) {
+				best = candidate;
+			}
 		}
+		return best;
 	}
 
 	size_t maxFrames_;
 	size_t head_;      // Next write position
 	size_t count_;     // Current number of frames (up to maxFrames_)
-	std::vector<float> beatActivations_;
-	std::vector<float> downbeatActivations_;
+	MirroredRing beatRing_;
+	MirroredRing downbeatRing_;
+
+	// Decimated long-window tier (4:1 averaged, 12.5 FPS)
+	MirroredRing decimatedBeatRing_;
+	MirroredRing decimatedDownbeatRing_;
+	size_t decimatedHead_ = 0;
+	size_t decimatedCount_ = 0;
+	float pendingBeat_ = 0.0f;
+	float pendingDownbeat_ = 0.0f;
+	size_t pendingFrames_ = 0;
+
+	// Stateful estimator, sized once in the ctor so the periodic recompute
+	// during push() is allocation-free
+	AutocorrBpmEstimator estimator_;
+
+	// Incremental comb filterbank, updated per frame in push()
+	CombTempoTracker combTracker_;
 
 	// BPM caching
 	float cachedBpm_;
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "StateBlob.hpp"
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+namespace engine {
+
+/**
+ * Incremental comb-filterbank tempo tracker.
+ *
+ * Alternative to AutocorrBpmEstimator for the real-time capture path: the
+ * autocorrelation recomputes a full FFT over the window on a timer, while
+ * this bank does constant small work per activation frame, so the CPU
+ * profile stays flat instead of bursting every recompute.
+ *
+ * One resonating comb filter per candidate BPM (60-180 at 0.5 BPM steps).
+ * Each filter feeds its own output back at the candidate beat period:
+ *
+ *   y[n] = (1 - alpha) * x[n] + alpha * y[n - T]
+ *
+ * Periods are fractional, so the delayed tap is linearly interpolated from
+ * the filter's output ring. A filter whose period matches the activation
+ * periodicity reinforces itself and accumulates energy; mismatched filters
+ * smear out. Tempo is read off the bank as the energy argmax with parabolic
+ * refinement across the BPM grid, the same refinement the autocorrelation
+ * path uses across lags.
+ */
+class CombTempoTracker {
+public:
+	static constexpr float FPS = 50.0f;
+	static constexpr float MIN_BPM = 60.0f;
+	static constexpr float MAX_BPM = 180.0f;
+	static constexpr float BPM_STEP = 0.5f;
+
+	// DJ music typical range for octave correction
+	static constexpr float DJ_MIN_BPM = 75.0f;
+	static constexpr float DJ_MAX_BPM = 165.0f;
+
+	// Feedback energy half-life: long enough to discriminate 0.5 BPM
+	// neighbours, short enough to follow a track transition
+	static constexpr float HALF_LIFE_SECONDS = 2.0f;
+
+	// Need ~2 seconds of frames before the bank state is meaningful
+	static constexpr size_t MIN_FRAMES = 100;
+
+	static constexpr int NUM_BANDS =
+		static_cast<int>((MAX_BPM - MIN_BPM) / BPM_STEP) + 1;  // 241
+
+	CombTempoTracker() {
+		bands_.resize(NUM_BANDS);
+		for (int b = 0; b < NUM_BANDS; b++) {
+			float bpm = MIN_BPM + b * BPM_STEP;
+			Band& band = bands_[b];
+			band.delay = FPS * 60.0f / bpm;
+			band.alpha = std::pow(0.5f, band.delay / (FPS * HALF_LIFE_SECONDS));
+			band.ring.assign(static_cast<size_t>(std::ceil(band.delay)) + 2, 0.0f);
+			band.head = 0;
+			band.energy = 0.0f;
+		}
+	}
+
+	/**
+	 * Feed one activation frame (beat + downbeat sum) through the bank.
+	 * Constant work: one interpolated tap + multiply-add per candidate BPM.
+	 */
+	void push(float activation) {
+		for (Band& band : bands_) {
+			size_t len = band.ring.size();
+			size_t whole = static_cast<size_t>(band.delay);
+			float frac = band.delay - static_cast<float>(whole);
+
+			// y[n - delay] via linear interpolation of the output ring
+			// (head is the write slot for y[n], so y[n - k] sits k behind it)
+			size_t idx0 = (band.head + len - whole) % len;
+			size_t idx1 = (idx0 + len - 1) % len;
+			float delayed = band.ring[idx0] * (1.0f - frac) + band.ring[idx1] * frac;
+
+			float y = (1.0f - band.alpha) * activation + band.alpha * delayed;
+			band.ring[band.head] = y;
+			band.head = (band.head + 1) % len;
+			band.energy = band.energy + ENERGY_ALPHA * (y * y - band.energy);
+		}
+		frames_++;
+	}
+
+	/**
+	 * Read the current tempo estimate off the bank state.
+	 * @param applyOctaveCorrection If true, correct half/double time for DJ range
+	 * @return Estimated BPM (0.5 BPM grid, parabolically refined between
+	 *         neighbouring bands), or 0 if insufficient data
+	 */
+	float estimate(bool applyOctaveCorrection = true) const {
+		if (frames_ < MIN_FRAMES) {
+			return 0.0f;
+		}
+
+		// Energy argmax over the bank
+		int peakIdx = 0;
+		float peakVal = bands_[0].energy;
+		for (int b = 1; b < NUM_BANDS; b++) {
+			if (bands_[b].energy > peakVal) {
+				peakVal = bands_[b].energy;
+				peakIdx = b;
+			}
+		}
+
+		// Refine with parabolic interpolation across the BPM grid
+		float refinedIdx = static_cast<float>(peakIdx);
+		if (peakIdx > 0 && peakIdx < NUM_BANDS - 1) {
+			float y0 = bands_[peakIdx - 1].energy;
+			float y1 = bands_[peakIdx].energy;
+			float y2 = bands_[peakIdx + 1].energy;
+			if (y1 > y0 && y1 > y2) {  // Valid peak
+				float denom = y0 - 2.0f * y1 + y2;
+				if (std::fabs(denom) > 1e-12f) {
+					float offset = 0.5f * (y0 - y2) / denom;
+					refinedIdx = peakIdx + offset;
+				}
+			}
+		}
+
+		// No snapping back to the grid: the refinement offset is at most a
+		// quarter step, so rounding would always undo it
+		float bpm = MIN_BPM + refinedIdx * BPM_STEP;
+
+		// Apply octave correction for DJ range
+		if (applyOctaveCorrection && bpm > 0) {
+			float doubled = bpm * 2.0f;
+			float halved = bpm / 2.0f;
+
+			if (bpm < DJ_MIN_BPM && doubled >= DJ_MIN_BPM && doubled <= DJ_MAX_BPM) {
+				bpm = doubled;
+			} else if (bpm > DJ_MAX_BPM && halved >= DJ_MIN_BPM && halved <= DJ_MAX_BPM) {
+				bpm = halved;
+			}
+		}
+
+		return bpm;
+	}
+
+	/**
+	 * Number of activation frames pushed since construction/clear.
+	 */
+	size_t frameCount() const {
+		return frames_;
+	}
+
+	void clear() {
+		for (Band& band : bands_) {
+			std::fill(band.ring.begin(), band.ring.end(), 0.0f);
+			band.head = 0;
+			band.energy = 0.0f;
+		}
+		frames_ = 0;
+	}
+
+	/** Serialize bank state (delay lines, heads, energies) for snapshots */
+	void saveState(StateWriter& w) const {
+		w.write(static_cast<uint64_t>(frames_));
+		for (const Band& band : bands_) {
+			w.write(static_cast<uint32_t>(band.ring.size()));
+			w.writeFloats(band.ring.data(), band.ring.size());
+			w.write(static_cast<uint64_t>(band.head));
+			w.write(band.energy);
+		}
+	}
+
+	/** Restore bank state; delay-line sizes must match this build's layout */
+	bool loadState(StateReader& r) {
+		uint64_t frames = 0;
+		if (!r.read(frames)) {
+			return false;
+		}
+		for (Band& band : bands_) {
+			if (!r.expect(static_cast<uint32_t>(band.ring.size())) ||
+			    !r.readFloats(band.ring.data(), band.ring.size())) {
+				return false;
+			}
+			uint64_t head = 0;
+			if (!r.read(head) || head >= band.ring.size() || !r.read(band.energy)) {
+				return false;
+			}
+			band.head = static_cast<size_t>(head);
+		}
+		frames_ = static_cast<size_t>(frames);
+		return true;
+	}
+
+private:
+	// Energy smoothing over ~2 seconds at 50 FPS
+	static constexpr float ENERGY_ALPHA = 0.01f;
+
+	struct Band {
+		float delay;              // Beat period in frames (fractional)
+		float alpha;              // Feedback gain for HALF_LIFE_SECONDS
+		std::vector<float> ring;  // Output delay line
+		size_t head;              // Next write position
+		float energy;             // Smoothed output energy
+	};
+
+	std::vector<Band> bands_;
+	size_t frames_ = 0;
+};
+
+} // namespace engine
@@ -13,11 +13,26 @@
  */
 
 #include "CqtExtractor.hpp"
+#include "FFT.hpp"
+#include "MirroredRing.hpp"
+#include "Resampler.hpp"
+#include "VecMath.hpp"
+#include "pocketfft_hdronly.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <cmath>
 #include <cstring>
 #include <limits>
+#include <string>
+
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX__)
+#include <immintrin.h>
+#endif
 
 namespace engine {
 
@@ -65,60 +80,479 @@ static std::vector<int> computeFilterLengths(const std::vector<float>& freqs,
 	return lengths;
 }
 
-/**
- * Create Hann window (matches librosa with fftbins=True)
- * Periodic/asymmetric window: w[n] = 0.5 * (1 - cos(2*pi*n / N))
- */
-static void createHannWindow(float* window, int length) {
-	for (int i = 0; i < length; i++) {
-		// Periodic window (fftbins=True in scipy)
-		window[i] = 0.5f * (1.0f - std::cos(TWO_PI * i / length));
-	}
-}
-
 /**
  * Create CQT kernel for a single bin
  *
  * The kernel is: window[n] * exp(+2*pi*i * f_k * n / sr)
- * (positive frequency, matching librosa)
+ * with a periodic Hann window w[n] = 0.5 * (1 - cos(2*pi*n / N))
+ * (positive frequency and fftbins=True, matching librosa)
+ *
+ * Both the window and the exponential advance by a fixed angle per sample,
+ * so each is generated with a double-precision rotation recurrence: four
+ * transcendental calls per kernel instead of three per sample. Over the
+ * longest 23,154-sample kernel the recurrence drift is ~1e-12, far below
+ * float precision.
  */
 static CqtKernel createKernel(float centerFreq, int filterLength, int sampleRate) {
 	CqtKernel kernel;
 	kernel.centerFreq = centerFreq;
 	kernel.filterLength = filterLength;
-	kernel.kernel.resize(filterLength);
+	kernel.real.resize(filterLength);
+	kernel.imag.resize(filterLength);
 
-	// Create window (periodic/asymmetric like librosa)
-	std::vector<float> window(filterLength);
-	createHannWindow(window.data(), filterLength);
+	// Window rotation: angle 2*pi/N per sample
+	const double windowStep = TWO_PI / filterLength;
+	const double windowCos = std::cos(windowStep);
+	const double windowSin = std::sin(windowStep);
+	double wc = 1.0;  // cos(windowStep * n)
+	double ws = 0.0;  // sin(windowStep * n)
 
-	// Create complex exponential kernel with window
-	// kernel[n] = window[n] * exp(+2*pi*i * f * n / sr)
-	// Using positive frequency to match librosa
-	const double freqRatio = TWO_PI * centerFreq / sampleRate;
+	// Exponential rotation: angle 2*pi*f/sr per sample
+	const double phaseStep = TWO_PI * centerFreq / sampleRate;
+	const double phaseCos = std::cos(phaseStep);
+	const double phaseSin = std::sin(phaseStep);
+	double pc = 1.0;  // cos(phaseStep * n)
+	double ps = 0.0;  // sin(phaseStep * n)
 
 	for (int n = 0; n < filterLength; n++) {
-		double phase = freqRatio * n;  // Positive phase (librosa convention)
-		float real = window[n] * std::cos(phase);
-		float imag = window[n] * std::sin(phase);
-		kernel.kernel[n] = std::complex<float>(real, imag);
+		const double window = 0.5 * (1.0 - wc);
+		kernel.real[n] = static_cast<CqtCoeff>(window * pc);
+		kernel.imag[n] = static_cast<CqtCoeff>(window * ps);
+
+		const double wcNext = wc * windowCos - ws * windowSin;
+		ws = ws * windowCos + wc * windowSin;
+		wc = wcNext;
+
+		const double pcNext = pc * phaseCos - ps * phaseSin;
+		ps = ps * phaseCos + pc * phaseSin;
+		pc = pcNext;
 	}
 
 	return kernel;
 }
 
+// ============================================================================
+// Kernel Cache
+// ============================================================================
+
+// Directory for the serialized kernel blob; empty disables caching
+static std::string kernelCacheDir;
+
+/**
+ * Serialized kernel blob header
+ *
+ * The version and the CQT parameters are both checked on load: a blob written
+ * by a different build configuration (or a truncated write) falls back to
+ * synthesis and is rewritten.
+ */
+struct KernelCacheHeader {
+	uint32_t magic;          // 'CQTK'
+	uint32_t version;
+	int32_t nBins;
+	int32_t sampleRate;
+	float fMin;
+	int32_t binsPerOctave;
+	int32_t maxFilterLength;
+	int32_t coeffBytes;      // sizeof(CqtCoeff): fp16 and fp32 blobs differ
+};
+
+static constexpr uint32_t KERNEL_CACHE_MAGIC = 0x4351544Bu;  // "CQTK"
+static constexpr uint32_t KERNEL_CACHE_VERSION = 2;
+
+static std::string kernelCacheFile() {
+	return kernelCacheDir + "/cqt_kernels_v2.bin";
+}
+
+/**
+ * Load precomputed kernels from the cache blob
+ *
+ * Every field is validated against the values this build would synthesize;
+ * any mismatch or short read rejects the whole blob.
+ */
+static bool loadKernelCache(std::vector<CqtKernel>& kernels,
+                            const std::vector<float>& freqs,
+                            const std::vector<int>& lengths,
+                            int maxFilterLength) {
+	FILE* file = std::fopen(kernelCacheFile().c_str(), "rb");
+	if (!file) return false;
+
+	KernelCacheHeader header = {};
+	bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+	          header.magic == KERNEL_CACHE_MAGIC &&
+	          header.version == KERNEL_CACHE_VERSION &&
+	          header.nBins == CqtConfig::N_BINS &&
+	          header.sampleRate == CqtConfig::SAMPLE_RATE &&
+	          header.fMin == CqtConfig::F_MIN &&
+	          header.binsPerOctave == CqtConfig::BINS_PER_OCTAVE &&
+	          header.maxFilterLength == maxFilterLength &&
+	          header.coeffBytes == static_cast<int32_t>(sizeof(CqtCoeff));
+
+	for (int k = 0; ok && k < CqtConfig::N_BINS; k++) {
+		float centerFreq = 0.0f;
+		int32_t filterLength = 0;
+		ok = std::fread(&centerFreq, sizeof(centerFreq), 1, file) == 1 &&
+		     std::fread(&filterLength, sizeof(filterLength), 1, file) == 1 &&
+		     centerFreq == freqs[k] && filterLength == lengths[k];
+		if (!ok) break;
+
+		CqtKernel& kernel = kernels[k];
+		kernel.centerFreq = centerFreq;
+		kernel.filterLength = filterLength;
+		kernel.real.resize(filterLength);
+		kernel.imag.resize(filterLength);
+		const size_t n = static_cast<size_t>(filterLength);
+		ok = std::fread(kernel.real.data(), sizeof(CqtCoeff), n, file) == n &&
+		     std::fread(kernel.imag.data(), sizeof(CqtCoeff), n, file) == n;
+	}
+
+	std::fclose(file);
+	return ok;
+}
+
+/**
+ * Write the synthesized kernels to the cache blob (best effort - a failed
+ * write just means the next construction synthesizes again)
+ */
+static void saveKernelCache(const std::vector<CqtKernel>& kernels,
+                            int maxFilterLength) {
+	FILE* file = std::fopen(kernelCacheFile().c_str(), "wb");
+	if (!file) return;
+
+	KernelCacheHeader header = {};
+	header.magic = KERNEL_CACHE_MAGIC;
+	header.version = KERNEL_CACHE_VERSION;
+	header.nBins = CqtConfig::N_BINS;
+	header.sampleRate = CqtConfig::SAMPLE_RATE;
+	header.fMin = CqtConfig::F_MIN;
+	header.binsPerOctave = CqtConfig::BINS_PER_OCTAVE;
+	header.maxFilterLength = maxFilterLength;
+	header.coeffBytes = static_cast<int32_t>(sizeof(CqtCoeff));
+	std::fwrite(&header, sizeof(header), 1, file);
+
+	for (const auto& kernel : kernels) {
+		const int32_t filterLength = kernel.filterLength;
+		std::fwrite(&kernel.centerFreq, sizeof(kernel.centerFreq), 1, file);
+		std::fwrite(&filterLength, sizeof(filterLength), 1, file);
+		std::fwrite(kernel.real.data(), sizeof(CqtCoeff), kernel.real.size(), file);
+		std::fwrite(kernel.imag.data(), sizeof(CqtCoeff), kernel.imag.size(), file);
+	}
+
+	std::fclose(file);
+}
+
+/**
+ * Correlate a real signal against a split-complex kernel (conjugated)
+ *
+ * Computes sum(audio[n] * conj(kernel[n])), i.e.
+ *   realOut =  dot(audio, real)
+ *   imagOut = -dot(audio, imag)
+ *
+ * The split real/imag planes make this two independent real dot products,
+ * which map directly onto vDSP/NEON/AVX and auto-vectorize well in the
+ * scalar fallback.
+ *
+ * With ENGINE_CQT_FP16 the kernel planes arrive in half precision and are
+ * widened to float32 per vector load; the accumulators stay float32.
+ */
+#if defined(ENGINE_CQT_FP16)
+static void complexCorrelate(const float* audio, const CqtCoeff* real, const CqtCoeff* imag,
+                             int len, float& realOut, float& imagOut) {
+#if defined(__ARM_NEON)
+	float32x4_t reAcc = vdupq_n_f32(0.0f);
+	float32x4_t imAcc = vdupq_n_f32(0.0f);
+	int n = 0;
+	for (; n + 4 <= len; n += 4) {
+		float32x4_t x = vld1q_f32(audio + n);
+		float32x4_t r = vcvt_f32_f16(vld1_f16(reinterpret_cast<const float16_t*>(real + n)));
+		float32x4_t i = vcvt_f32_f16(vld1_f16(reinterpret_cast<const float16_t*>(imag + n)));
+		reAcc = vmlaq_f32(reAcc, x, r);
+		imAcc = vmlaq_f32(imAcc, x, i);
+	}
+	float re = vaddvq_f32(reAcc);
+	float im = vaddvq_f32(imAcc);
+	for (; n < len; n++) {
+		re += audio[n] * static_cast<float>(real[n]);
+		im += audio[n] * static_cast<float>(imag[n]);
+	}
+	realOut = re;
+	imagOut = -im;
+#else
+	float re = 0.0f;
+	float im = 0.0f;
+	for (int n = 0; n < len; n++) {
+		re += audio[n] * static_cast<float>(real[n]);
+		im += audio[n] * static_cast<float>(imag[n]);
+	}
+	realOut = re;
+	imagOut = -im;
+#endif
+}
+#else
+static void complexCorrelate(const float* audio, const float* real, const float* imag,
+                             int len, float& realOut, float& imagOut) {
+#if defined(__APPLE__)
+	float re = 0.0f;
+	float im = 0.0f;
+	vDSP_dotpr(audio, 1, real, 1, &re, static_cast<vDSP_Length>(len));
+	vDSP_dotpr(audio, 1, imag, 1, &im, static_cast<vDSP_Length>(len));
+	realOut = re;
+	imagOut = -im;
+#elif defined(__ARM_NEON)
+	float32x4_t reAcc = vdupq_n_f32(0.0f);
+	float32x4_t imAcc = vdupq_n_f32(0.0f);
+	int n = 0;
+	for (; n + 4 <= len; n += 4) {
+		float32x4_t x = vld1q_f32(audio + n);
+		reAcc = vmlaq_f32(reAcc, x, vld1q_f32(real + n));
+		imAcc = vmlaq_f32(imAcc, x, vld1q_f32(imag + n));
+	}
+	float re = vaddvq_f32(reAcc);
+	float im = vaddvq_f32(imAcc);
+	for (; n < len; n++) {
+		re += audio[n] * real[n];
+		im += audio[n] * imag[n];
+	}
+	realOut = re;
+	imagOut = -im;
+#elif defined(__AVX__)
+	__m256 reAcc = _mm256_setzero_ps();
+	__m256 imAcc = _mm256_setzero_ps();
+	int n = 0;
+	for (; n + 8 <= len; n += 8) {
+		__m256 x = _mm256_loadu_ps(audio + n);
+		reAcc = _mm256_add_ps(reAcc, _mm256_mul_ps(x, _mm256_loadu_ps(real + n)));
+		imAcc = _mm256_add_ps(imAcc, _mm256_mul_ps(x, _mm256_loadu_ps(imag + n)));
+	}
+	alignas(32) float reLanes[8];
+	alignas(32) float imLanes[8];
+	_mm256_store_ps(reLanes, reAcc);
+	_mm256_store_ps(imLanes, imAcc);
+	float re = 0.0f;
+	float im = 0.0f;
+	for (int j = 0; j < 8; j++) {
+		re += reLanes[j];
+		im += imLanes[j];
+	}
+	for (; n < len; n++) {
+		re += audio[n] * real[n];
+		im += audio[n] * imag[n];
+	}
+	realOut = re;
+	imagOut = -im;
+#else
+	float re = 0.0f;
+	float im = 0.0f;
+	for (int n = 0; n < len; n++) {
+		re += audio[n] * real[n];
+		im += audio[n] * imag[n];
+	}
+	realOut = re;
+	imagOut = -im;
+#endif
+}
+#endif  // ENGINE_CQT_FP16
+
+/**
+ * Sparse spectral-domain CQT kernel for a single bin
+ *
+ * The DFT of a windowed exponential kernel is concentrated in a narrow band
+ * around the bin's center frequency; coefficients outside that band are
+ * dropped. Weights are pre-conjugated and scaled by 1/FFT_SIZE so the
+ * per-frame evaluation is a plain sparse complex dot product against the
+ * frame's spectrum.
+ */
+struct SparseSpectralKernel {
+	int firstBin;                                // First retained FFT bin
+	std::vector<std::complex<float>> weights;    // conj(K[j]) / FFT_SIZE
+};
+
+/**
+ * Compute the sparse spectral kernel for a single bin
+ *
+ * The time-domain kernel is placed centered in a MAX_FILTER_LENGTH window
+ * (matching the alignment used by the time-domain path), transformed with a
+ * full-size FFT, and trimmed from both ends until the dropped cumulative
+ * energy reaches KERNEL_SPARSITY of the kernel's total power, leaving one
+ * contiguous band of retained bins.
+ */
+static SparseSpectralKernel createSpectralKernel(const CqtKernel& timeKernel) {
+	const int fftSize = CqtConfig::FFT_SIZE;
+	const int offset = (CqtConfig::MAX_FILTER_LENGTH - timeKernel.filterLength) / 2;
+
+	// Zero-padded, centered copy of the time kernel (re-interleaved from the
+	// split planes for the one-time kernel FFT)
+	std::vector<std::complex<float>> padded(fftSize, {0.0f, 0.0f});
+	for (int n = 0; n < timeKernel.filterLength; n++) {
+		padded[offset + n] = std::complex<float>(static_cast<float>(timeKernel.real[n]),
+		                                         static_cast<float>(timeKernel.imag[n]));
+	}
+
+	// Full complex FFT (the kernel is complex, so r2c does not apply)
+	std::vector<std::complex<float>> spectrum(fftSize);
+	pocketfft::shape_t shape = {static_cast<size_t>(fftSize)};
+	pocketfft::stride_t stride = {sizeof(std::complex<float>)};
+	pocketfft::shape_t axes = {0};
+	pocketfft::c2c(shape, stride, stride, axes, pocketfft::FORWARD,
+	               padded.data(), spectrum.data(), 1.0f);
+
+	// The kernel uses a positive-frequency exponential, so its energy lives in
+	// bins [0, fftSize/2]. Trim bins from both ends of that range until the
+	// dropped energy reaches KERNEL_SPARSITY of the kernel's total energy -
+	// this keeps the sidelobes that still contribute to the response.
+	const int numBins = fftSize / 2 + 1;
+	double totalPower = 0.0;
+	for (int j = 0; j < numBins; j++) {
+		totalPower += std::norm(spectrum[j]);
+	}
+	const double budget = CqtConfig::KERNEL_SPARSITY * totalPower;
+
+	int lo = 0;
+	int hi = numBins - 1;
+	double dropped = 0.0;
+	while (lo < hi) {
+		const double loPower = std::norm(spectrum[lo]);
+		const double hiPower = std::norm(spectrum[hi]);
+		if (loPower <= hiPower) {
+			if (dropped + loPower > budget) break;
+			dropped += loPower;
+			lo++;
+		} else {
+			if (dropped + hiPower > budget) break;
+			dropped += hiPower;
+			hi--;
+		}
+	}
+
+	SparseSpectralKernel sparse;
+	sparse.firstBin = lo;
+	sparse.weights.resize(hi - lo + 1);
+	const float scale = 1.0f / static_cast<float>(fftSize);
+	for (int j = lo; j <= hi; j++) {
+		sparse.weights[j - lo] = std::conj(spectrum[j]) * scale;
+	}
+	return sparse;
+}
+
+/**
+ * Group of CQT bins evaluated at a common decimated sample rate
+ *
+ * Octave o (counted from the top of the bin range) runs at SAMPLE_RATE / 2^o,
+ * so its kernels are 2^o times shorter than their full-rate equivalents.
+ */
+struct OctaveGroup {
+	int firstBin;                    // First bin index in this group
+	int lastBin;                     // Last bin index (inclusive)
+	int decimation;                  // Rate divisor exponent (rate = sr / 2^decimation)
+	std::vector<CqtKernel> kernels;  // Kernels built at the decimated rate
+};
+
+// ============================================================================
+// Resonator Bank (Resonator method)
+// ============================================================================
+
+/**
+ * Bank of complex one-pole resonators - a sliding Goertzel per bin.
+ *
+ * Each bin k holds a complex state updated once per input sample:
+ *
+ *   s_k <- r_k * e^{-iw_k} * s_k + x[n]
+ *
+ * which accumulates sum_m x[n-m] * r_k^m * e^{-iw_k m}: the bin's
+ * correlation under an exponentially decaying window. The pole radius
+ * r_k = 1 - 2 / N_k gives that window the same weight sum (N_k / 2) as the
+ * periodic Hann window of the bin's filter length, so bandwidth and output
+ * scale line up with the windowed-kernel engines. Work is O(N_BINS) per
+ * sample with no window re-reads, so CPU cost is spread evenly across
+ * audio callbacks instead of spiking at each hop.
+ *
+ * Poles and states are split real/imag arrays so the per-sample update is
+ * one vectorizable pass over the bank.
+ */
+struct ResonatorBank {
+	std::vector<float> poleRe;    //  r_k * cos(w_k)
+	std::vector<float> poleIm;    // -r_k * sin(w_k)
+	std::vector<float> stateRe;
+	std::vector<float> stateIm;
+	std::vector<float> outScale;  // 4 / N_k matches the kernel engines' |.|^2 scale
+
+	ResonatorBank(const std::vector<float>& freqs, const std::vector<int>& lengths) {
+		const int n = static_cast<int>(freqs.size());
+		poleRe.resize(n);
+		poleIm.resize(n);
+		stateRe.assign(n, 0.0f);
+		stateIm.assign(n, 0.0f);
+		outScale.resize(n);
+		for (int k = 0; k < n; k++) {
+			const double w = TWO_PI * freqs[k] / CqtConfig::SAMPLE_RATE;
+			const double r = 1.0 - 2.0 / lengths[k];
+			poleRe[k] = static_cast<float>(r * std::cos(w));
+			poleIm[k] = static_cast<float>(-r * std::sin(w));
+			outScale[k] = 4.0f / static_cast<float>(lengths[k]);
+		}
+	}
+
+	void reset() {
+		std::fill(stateRe.begin(), stateRe.end(), 0.0f);
+		std::fill(stateIm.begin(), stateIm.end(), 0.0f);
+	}
+
+	/** Advance every resonator by one sample: one complex multiply-add per bin */
+	void step(float x) {
+		const int n = static_cast<int>(stateRe.size());
+		for (int k = 0; k < n; k++) {
+			const float re = poleRe[k] * stateRe[k] - poleIm[k] * stateIm[k] + x;
+			stateIm[k] = poleRe[k] * stateIm[k] + poleIm[k] * stateRe[k];
+			stateRe[k] = re;
+		}
+	}
+
+	/** Read squared magnitudes off the states (finalizeBins still applies) */
+	void readBins(float* cqtBins) const {
+		const int n = static_cast<int>(stateRe.size());
+		for (int k = 0; k < n; k++) {
+			cqtBins[k] = (stateRe[k] * stateRe[k] + stateIm[k] * stateIm[k]) * outScale[k];
+		}
+	}
+};
+
+/**
+ * Shared output epilogue: bins arrive as squared magnitudes and leave as
+ * log1p-scaled magnitudes. Batching the sqrt and log1p across all 105 bins
+ * lets VecMath vectorize them instead of calling scalar libm per bin.
+ */
+static void finalizeBins(float* cqtBins) {
+	vecmath::sqrt(cqtBins, cqtBins, CqtConfig::N_BINS);
+	vecmath::log1p(cqtBins, cqtBins, CqtConfig::N_BINS);
+}
+
 // ============================================================================
 // CqtExtractor Implementation
 // ============================================================================
 
 struct CqtExtractor::Impl {
+	CqtMethod method;
 	std::vector<CqtKernel> kernels;
 	std::vector<float> centerFrequencies;
 	std::vector<int> filterLengths;
 	double Q;
 	int maxFilterLength;
 
-	Impl() {
+	// Spectral-kernel engine state (SparseFft only)
+	std::vector<SparseSpectralKernel> spectralKernels;
+	std::unique_ptr<FFT> fft;
+	std::vector<float> fftInput;
+	std::vector<std::complex<float>> spectrum;
+
+	// Multirate engine state (Multirate only)
+	std::vector<OctaveGroup> octaveGroups;
+	std::unique_ptr<Resampler> halfband;
+	std::vector<std::vector<float>> levelBuffers;    // Window at sr / 2^level
+	std::vector<int> levelLengths;                   // Valid samples per level
+
+	// Resonator engine state (Resonator only)
+	std::unique_ptr<ResonatorBank> resonators;
+
+	explicit Impl(CqtMethod m) : method(m) {
 		// Compute Q factor
 		Q = computeQFactor(CqtConfig::BINS_PER_OCTAVE);
 
@@ -133,25 +567,233 @@ struct CqtExtractor::Impl {
 		// Find max filter length
 		maxFilterLength = *std::max_element(filterLengths.begin(), filterLengths.end());
 
-		// Pre-compute kernels for each bin
+		// Pre-compute kernels for each bin, or load them from the serialized
+		// cache when a cache directory is configured
 		kernels.resize(CqtConfig::N_BINS);
-		for (int k = 0; k < CqtConfig::N_BINS; k++) {
-			kernels[k] = createKernel(
-				centerFrequencies[k], filterLengths[k], CqtConfig::SAMPLE_RATE);
+		const bool cached = !kernelCacheDir.empty() &&
+			loadKernelCache(kernels, centerFrequencies, filterLengths, maxFilterLength);
+		if (!cached) {
+			for (int k = 0; k < CqtConfig::N_BINS; k++) {
+				kernels[k] = createKernel(
+					centerFrequencies[k], filterLengths[k], CqtConfig::SAMPLE_RATE);
+			}
+			if (!kernelCacheDir.empty()) {
+				saveKernelCache(kernels, maxFilterLength);
+			}
+		}
+
+		if (method == CqtMethod::SparseFft) {
+			// Transform each time kernel to its sparse spectral form, then
+			// drop the time-domain copies - the FFT path never touches them.
+			spectralKernels.resize(CqtConfig::N_BINS);
+			for (int k = 0; k < CqtConfig::N_BINS; k++) {
+				spectralKernels[k] = createSpectralKernel(kernels[k]);
+				kernels[k].real.clear();
+				kernels[k].real.shrink_to_fit();
+				kernels[k].imag.clear();
+				kernels[k].imag.shrink_to_fit();
+			}
+
+			fft = std::make_unique<FFT>(CqtConfig::FFT_SIZE);
+			fftInput.resize(CqtConfig::FFT_SIZE, 0.0f);
+			spectrum.resize(fft->getOutputSize());
+		}
+
+		if (method == CqtMethod::Multirate) {
+			// Group bins into octaves from the top: octave o covers the o-th
+			// highest BINS_PER_OCTAVE bins and runs at SAMPLE_RATE / 2^o.
+			// Full-rate time kernels are never touched on this path.
+			for (auto& kernel : kernels) {
+				kernel.real.clear();
+				kernel.real.shrink_to_fit();
+				kernel.imag.clear();
+				kernel.imag.shrink_to_fit();
+			}
+
+			halfband = std::make_unique<Resampler>();
+
+			int levels = 0;
+			for (int last = CqtConfig::N_BINS - 1; last >= 0;
+			     last -= CqtConfig::BINS_PER_OCTAVE) {
+				OctaveGroup group;
+				group.lastBin = last;
+				group.firstBin = std::max(0, last - CqtConfig::BINS_PER_OCTAVE + 1);
+				group.decimation = levels;
+
+				const int decimatedRate = CqtConfig::SAMPLE_RATE >> group.decimation;
+				for (int k = group.firstBin; k <= group.lastBin; k++) {
+					const int len = static_cast<int>(
+						std::ceil(Q * decimatedRate / centerFrequencies[k]));
+					group.kernels.push_back(
+						createKernel(centerFrequencies[k], len, decimatedRate));
+				}
+
+				octaveGroups.push_back(std::move(group));
+				levels++;
+			}
+
+			// Pre-size the cascade buffers: each halfband stage roughly halves
+			// the window (minus the filter's edge loss).
+			levelBuffers.resize(levels);
+			levelLengths.resize(levels, 0);
+			int levelSize = maxFilterLength;
+			for (int d = 0; d < levels; d++) {
+				levelBuffers[d].resize(levelSize, 0.0f);
+				levelSize = halfband->getOutputSize(levelSize);
+			}
+		}
+
+		if (method == CqtMethod::Resonator) {
+			// The bank replaces the kernels entirely; drop the time-domain
+			// copies synthesized above
+			for (auto& kernel : kernels) {
+				kernel.real.clear();
+				kernel.real.shrink_to_fit();
+				kernel.imag.clear();
+				kernel.imag.shrink_to_fit();
+			}
+
+			resonators = std::make_unique<ResonatorBank>(centerFrequencies, filterLengths);
 		}
 	}
 };
 
-CqtExtractor::CqtExtractor() : impl_(std::make_unique<Impl>()) {}
+CqtExtractor::CqtExtractor(CqtMethod method) : impl_(std::make_unique<Impl>(method)) {}
 
 CqtExtractor::~CqtExtractor() = default;
 
 void CqtExtractor::reset() {
-	// No state to reset for single-frame extractor
+	// Only the resonator engine carries state between frames
+	if (impl_->resonators) {
+		impl_->resonators->reset();
+	}
 }
 
 bool CqtExtractor::processFrame(const float* audio, int numSamples, float* cqtBins) {
-	const auto& impl = *impl_;
+	auto& impl = *impl_;
+
+	if (impl.method == CqtMethod::SparseFft) {
+		const int maxLen = impl.maxFilterLength;
+
+		// Center the analysis window in the FFT buffer exactly as the
+		// time-domain path centers each kernel within the provided audio.
+		std::fill(impl.fftInput.begin(), impl.fftInput.end(), 0.0f);
+		if (numSamples >= maxLen) {
+			const float* src = audio + (numSamples - maxLen) / 2;
+			std::copy(src, src + maxLen, impl.fftInput.begin());
+		} else {
+			std::copy(audio, audio + numSamples,
+			          impl.fftInput.begin() + (maxLen - numSamples) / 2);
+		}
+
+		// One FFT of the frame, then a sparse complex dot product per bin.
+		// By Parseval: sum(x[n] * conj(k[n])) = (1/N) * sum(X[j] * conj(K[j])),
+		// and the negative-frequency half of K is ~zero for these kernels.
+		impl.fft->forward(impl.fftInput.data(), impl.spectrum.data());
+
+		for (int k = 0; k < CqtConfig::N_BINS; k++) {
+			const auto& sk = impl.spectralKernels[k];
+			const std::complex<float>* spec = impl.spectrum.data() + sk.firstBin;
+			const int count = static_cast<int>(sk.weights.size());
+
+			float realSum = 0.0f;
+			float imagSum = 0.0f;
+			for (int j = 0; j < count; j++) {
+				const std::complex<float>& x = spec[j];
+				const std::complex<float>& w = sk.weights[j];
+				realSum += x.real() * w.real() - x.imag() * w.imag();
+				imagSum += x.real() * w.imag() + x.imag() * w.real();
+			}
+
+			// Same normalization and scaling as the time-domain path
+			float norm = std::sqrt(static_cast<float>(impl.filterLengths[k])) * 0.5f;
+			realSum /= norm;
+			imagSum /= norm;
+
+			cqtBins[k] = realSum * realSum + imagSum * imagSum;
+		}
+
+		finalizeBins(cqtBins);
+		return true;
+	}
+
+	if (impl.method == CqtMethod::Multirate) {
+		const int maxLen = impl.maxFilterLength;
+
+		// Level 0: centered full-rate window (zero-padded if short)
+		std::fill(impl.levelBuffers[0].begin(), impl.levelBuffers[0].end(), 0.0f);
+		if (numSamples >= maxLen) {
+			const float* src = audio + (numSamples - maxLen) / 2;
+			std::copy(src, src + maxLen, impl.levelBuffers[0].begin());
+		} else {
+			std::copy(audio, audio + numSamples,
+			          impl.levelBuffers[0].begin() + (maxLen - numSamples) / 2);
+		}
+		impl.levelLengths[0] = maxLen;
+
+		// Cascade of halfband decimations. The filter is linear-phase, so the
+		// window center is preserved (within a sample) at every level.
+		for (size_t d = 1; d < impl.levelBuffers.size(); d++) {
+			impl.levelLengths[d] = impl.halfband->process(
+				impl.levelBuffers[d - 1].data(), impl.levelLengths[d - 1],
+				impl.levelBuffers[d].data());
+		}
+
+		for (const auto& group : impl.octaveGroups) {
+			const float* level = impl.levelBuffers[group.decimation].data();
+			const int levelLen = impl.levelLengths[group.decimation];
+
+			// Each decimation halves the correlation sum, so scale it back up
+			// to match the full-rate normalization below.
+			const float scale = static_cast<float>(1 << group.decimation);
+
+			for (int k = group.firstBin; k <= group.lastBin; k++) {
+				const auto& kernel = group.kernels[k - group.firstBin];
+				int len = kernel.filterLength;
+
+				// Center the kernel in the decimated window. The cascade loses
+				// a few edge samples per stage; clip the (near-zero) Hann tails
+				// symmetrically when the window is slightly short.
+				int kernelOffset = 0;
+				if (len > levelLen) {
+					kernelOffset = (len - levelLen) / 2;
+					len = levelLen;
+				}
+				const float* windowStart = level + (levelLen - len) / 2;
+
+				float realSum = 0.0f;
+				float imagSum = 0.0f;
+				complexCorrelate(windowStart,
+				                 kernel.real.data() + kernelOffset,
+				                 kernel.imag.data() + kernelOffset,
+				                 len, realSum, imagSum);
+
+				// Normalize against the full-rate filter length so all three
+				// engines share one output scale.
+				float norm = std::sqrt(static_cast<float>(impl.filterLengths[k])) * 0.5f;
+				realSum = realSum * scale / norm;
+				imagSum = imagSum * scale / norm;
+
+				cqtBins[k] = realSum * realSum + imagSum * imagSum;
+			}
+		}
+
+		finalizeBins(cqtBins);
+		return true;
+	}
+
+	if (impl.method == CqtMethod::Resonator) {
+		// Run the bank causally across the window and read the states at
+		// its end: the exponential windows trail back from there instead
+		// of straddling the window center like the kernel engines
+		impl.resonators->reset();
+		for (int n = 0; n < numSamples; n++) {
+			impl.resonators->step(audio[n]);
+		}
+		impl.resonators->readBins(cqtBins);
+		finalizeBins(cqtBins);
+		return true;
+	}
 
 	// Process each bin
 	for (int k = 0; k < CqtConfig::N_BINS; k++) {
@@ -176,13 +818,8 @@ bool CqtExtractor::processFrame(const float* audio, int numSamples, float* cqtBi
 		// This computes the correlation (inner product) with the kernel
 		float realSum = 0.0f;
 		float imagSum = 0.0f;
-
-		for (int n = 0; n < len; n++) {
-			float sample = audioStart[n];
-			// Use conjugate of kernel: conj(a+bi) = a-bi
-			realSum += sample * kernel.kernel[n].real();
-			imagSum -= sample * kernel.kernel[n].imag();  // Note: minus for conjugate
-		}
+		complexCorrelate(audioStart, kernel.real.data(), kernel.imag.data(),
+		                 len, realSum, imagSum);
 
 		// Normalize by sqrt(filter length) / 2 to match librosa's FFT-based CQT
 		// The factor of 2 accounts for the difference between time-domain
@@ -191,13 +828,12 @@ bool CqtExtractor::processFrame(const float* audio, int numSamples, float* cqtBi
 		realSum /= norm;
 		imagSum /= norm;
 
-		// Compute magnitude
-		float magnitude = std::sqrt(realSum * realSum + imagSum * imagSum);
-
-		// Apply log1p scaling (matches preprocessing: np.log1p(np.abs(cqt)))
-		cqtBins[k] = std::log1p(magnitude);
+		// Squared magnitude; finalizeBins applies the batched sqrt and the
+		// log1p scaling (matches preprocessing: np.log1p(np.abs(cqt)))
+		cqtBins[k] = realSum * realSum + imagSum * imagSum;
 	}
 
+	finalizeBins(cqtBins);
 	return true;
 }
 
@@ -209,6 +845,14 @@ const std::vector<int>& CqtExtractor::getFilterLengths() const {
 	return impl_->filterLengths;
 }
 
+CqtMethod CqtExtractor::getMethod() const {
+	return impl_->method;
+}
+
+void CqtExtractor::setKernelCachePath(const std::string& dir) {
+	kernelCacheDir = dir;
+}
+
 // ============================================================================
 // StreamingCqtExtractor Implementation
 // ============================================================================
@@ -216,8 +860,9 @@ const std::vector<int>& CqtExtractor::getFilterLengths() const {
 struct StreamingCqtExtractor::Impl {
 	CqtExtractor extractor;
 
-	// Circular buffer for audio samples
-	std::vector<float> buffer;
+	// Double-mapped circular buffer for audio samples: any maxFilterLen
+	// window reads as a contiguous pointer, so frames need no copy-out
+	MirroredRing ring;
 	int64_t writePos;
 	int64_t samplesReceived;
 	int64_t frameCount;
@@ -230,25 +875,66 @@ struct StreamingCqtExtractor::Impl {
 	// Padding for centered framing (half of max filter length)
 	static constexpr int PADDING = CqtConfig::MAX_FILTER_LENGTH / 2;
 
-	Impl() : writePos(0), samplesReceived(0), frameCount(0) {
-		buffer.resize(BUFFER_SIZE, 0.0f);
+	// Resonator mode runs its own bank sample-by-sample and never touches
+	// the ring or the per-frame extractor path
+	std::unique_ptr<ResonatorBank> resonators;
 
+	explicit Impl(CqtMethod method)
+		: extractor(method), ring(BUFFER_SIZE),
+		  writePos(0), samplesReceived(0), frameCount(0) {
 		// Pre-fill with zeros for centered framing
 		// First frame is centered at sample 0, using zero-padding on the left
 		writePos = PADDING;
+
+		if (method == CqtMethod::Resonator) {
+			resonators = std::make_unique<ResonatorBank>(
+				extractor.getCenterFrequencies(), extractor.getFilterLengths());
+		}
 	}
 
 	void reset() {
-		std::fill(buffer.begin(), buffer.end(), 0.0f);
+		ring.fill(0.0f);
 		writePos = PADDING;
 		samplesReceived = 0;
 		frameCount = 0;
 		extractor.reset();
+		if (resonators) {
+			resonators->reset();
+		}
+	}
+
+	/**
+	 * Resonator push: O(N_BINS) per sample, no ring writes or window
+	 * re-reads. Frames follow the same schedule as the kernel engines so
+	 * the hop cadence (and callers' frame bookkeeping) is unchanged.
+	 */
+	int pushResonator(const float* samples, int numSamples,
+	                  float* cqtFrames, int maxFrames) {
+		const int hopLength = CqtConfig::HOP_LENGTH;
+		const int halfFilter = CqtConfig::MAX_FILTER_LENGTH / 2;
+
+		int framesProduced = 0;
+		for (int i = 0; i < numSamples; i++) {
+			resonators->step(samples[i]);
+			samplesReceived++;
+
+			while (samplesReceived >=
+			       frameCount * static_cast<int64_t>(hopLength) + halfFilter) {
+				if (framesProduced < maxFrames) {
+					float* out = cqtFrames + framesProduced * CqtConfig::N_BINS;
+					resonators->readBins(out);
+					finalizeBins(out);
+					framesProduced++;
+				}
+				frameCount++;
+			}
+		}
+		return framesProduced;
 	}
 };
 
-StreamingCqtExtractor::StreamingCqtExtractor()
-	: impl_(std::make_unique<Impl>()) {}
+StreamingCqtExtractor::StreamingCqtExtractor(CqtMethod method)
+	: impl_(std::make_unique<Impl>(method)) {}
 
 StreamingCqtExtractor::~StreamingCqtExtractor() = default;
 
@@ -259,46 +945,46 @@ void StreamingCqtExtractor::reset() {
 int StreamingCqtExtractor::push(const float* samples, int numSamples,
                                  float* cqtFrames, int maxFrames) {
 	auto& impl = *impl_;
+	if (impl.resonators) {
+		return impl.pushResonator(samples, numSamples, cqtFrames, maxFrames);
+	}
+
 	const int hopLength = CqtConfig::HOP_LENGTH;
 	const int maxFilterLen = impl.extractor.getMaxFilterLength();
 
 	int framesProduced = 0;
+	int consumed = 0;
+	const size_t ringCapacity = impl.ring.capacity();
 
-	for (int i = 0; i < numSamples; i++) {
-		// Write sample to buffer (with wrap-around)
-		impl.buffer[static_cast<size_t>(impl.writePos % Impl::BUFFER_SIZE)] = samples[i];
-		impl.writePos++;
-		impl.samplesReceived++;
-
-		// Check if we have enough samples for a frame
-		// Frame N is centered at sample N * hopLength
-		// We need maxFilterLen/2 samples after the center for centered framing
-		// samplesNeeded = N * hopLength + maxFilterLen/2
-		int64_t samplesNeeded =
-			impl.frameCount * static_cast<int64_t>(hopLength) + maxFilterLen / 2;
-
-		if (impl.samplesReceived >= samplesNeeded) {
-			// Frame N is centered at sample N * hopLength.
-			int64_t frameCenter = impl.frameCount * static_cast<int64_t>(hopLength);
+	while (consumed < numSamples) {
+		// Copy at most one hop of input into the ring per iteration: draining
+		// due frames between chunks guarantees no frame's oldest sample is
+		// overwritten before it is extracted (the ring holds maxFilterLen plus
+		// one hop of history). The mirrored mapping wraps writes automatically.
+		const int chunk = std::min(numSamples - consumed, hopLength);
+		impl.ring.store(static_cast<size_t>(impl.writePos % ringCapacity),
+		                samples + consumed, chunk);
+		impl.writePos += chunk;
+		impl.samplesReceived += chunk;
+		consumed += chunk;
 
+		// Drain every frame the chunk completed.
+		// Frame N is centered at sample N * hopLength and needs maxFilterLen/2
+		// samples after the center for centered framing.
+		while (impl.samplesReceived >=
+		       impl.frameCount * static_cast<int64_t>(hopLength) + maxFilterLen / 2) {
 			if (framesProduced < maxFrames) {
-				// We need maxFilterLen samples centered at frameCenter.
-				std::vector<float> frameAudio(maxFilterLen);
-
-				int64_t startSample = frameCenter - maxFilterLen / 2;
-				for (int j = 0; j < maxFilterLen; j++) {
-					int64_t sampleIdx = startSample + j;
-					// Map to buffer position (accounting for initial padding).
-					int64_t bufIdx = (Impl::PADDING + sampleIdx) % Impl::BUFFER_SIZE;
-					if (bufIdx < 0) {
-						bufIdx += Impl::BUFFER_SIZE;
-					}
-					frameAudio[j] = impl.buffer[static_cast<size_t>(bufIdx)];
-				}
+				// maxFilterLen samples centered at the frame position, read
+				// straight out of the mirrored ring with no copy-out. The
+				// PADDING offset keeps the start index non-negative for the
+				// zero-padded frames at stream start.
+				const int64_t start = Impl::PADDING +
+					impl.frameCount * static_cast<int64_t>(hopLength) - maxFilterLen / 2;
+				const float* frame =
+					impl.ring.window(static_cast<size_t>(start % ringCapacity));
 
-				// Process frame.
 				impl.extractor.processFrame(
-					frameAudio.data(), maxFilterLen,
+					frame, maxFilterLen,
 					cqtFrames + framesProduced * CqtConfig::N_BINS);
 
 				framesProduced++;
@@ -313,6 +999,45 @@ int StreamingCqtExtractor::push(const float* samples, int numSamples,
 	return framesProduced;
 }
 
+void StreamingCqtExtractor::saveState(StateWriter& w) const {
+	auto& impl = *impl_;
+	w.write(static_cast<uint8_t>(impl.resonators ? 1 : 0));
+	if (impl.resonators) {
+		w.writeFloats(impl.resonators->stateRe.data(), CqtConfig::N_BINS);
+		w.writeFloats(impl.resonators->stateIm.data(), CqtConfig::N_BINS);
+	} else {
+		w.write(static_cast<uint64_t>(impl.ring.capacity()));
+		w.writeFloats(impl.ring.window(0), impl.ring.capacity());
+	}
+	w.write(impl.writePos);
+	w.write(impl.samplesReceived);
+	w.write(impl.frameCount);
+}
+
+bool StreamingCqtExtractor::loadState(StateReader& r) {
+	auto& impl = *impl_;
+	if (!r.expect(static_cast<uint8_t>(impl.resonators ? 1 : 0))) {
+		return false;
+	}
+	if (impl.resonators) {
+		if (!r.readFloats(impl.resonators->stateRe.data(), CqtConfig::N_BINS) ||
+		    !r.readFloats(impl.resonators->stateIm.data(), CqtConfig::N_BINS)) {
+			return false;
+		}
+	} else {
+		if (!r.expect(static_cast<uint64_t>(impl.ring.capacity()))) {
+			return false;
+		}
+		std::vector<float> ring(impl.ring.capacity());
+		if (!r.readFloats(ring.data(), ring.size())) {
+			return false;
+		}
+		impl.ring.store(0, ring.data(), ring.size());
+	}
+	return r.read(impl.writePos) && r.read(impl.samplesReceived) &&
+	       r.read(impl.frameCount);
+}
+
 int StreamingCqtExtractor::getFrameCount() const {
 	if (impl_->frameCount > std::numeric_limits<int>::max()) {
 		return std::numeric_limits<int>::max();
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "StateBlob.hpp"
 #include <cstddef>
 #include <complex>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace engine {
@@ -30,18 +32,79 @@ struct CqtConfig {
 	// Max filter length (for lowest frequency bin: Q * sr / fmin)
 	// ≈ 34.127 * 44100 / 65 ≈ 23154 samples
 	static constexpr int MAX_FILTER_LENGTH = 23200;
+
+	// FFT size for the spectral-kernel engine (next power of 2 >= MAX_FILTER_LENGTH)
+	static constexpr int FFT_SIZE = 32768;
+
+	// Fraction of each spectral kernel's energy allowed to be trimmed when
+	// sparsifying (matches librosa's sparsity quantile in spirit)
+	static constexpr float KERNEL_SPARSITY = 1e-7f;
 };
 
+/**
+ * CQT evaluation method, selected at construction.
+ *
+ * TimeDomain: per-bin complex dot products against windowed exponentials.
+ *             Exact, but ~1.2M multiply-adds per frame.
+ * SparseFft:  librosa-style spectral evaluation - one FFT of the frame plus a
+ *             sparse complex matrix product against precomputed spectral
+ *             kernels. Equivalent output (to within kernel sparsification
+ *             error) at a fraction of the arithmetic.
+ * Multirate:  librosa-style recursive downsampling - each octave of bins is
+ *             correlated against kernels built for a progressively halved
+ *             sample rate, so the longest (lowest-frequency) kernels shrink
+ *             by the same factor as the rate. Cuts CQT arithmetic ~4x at the
+ *             cost of small halfband-filter passband error.
+ * Resonator:  bank of complex one-pole resonators (sliding Goertzel), one
+ *             O(bins) update per input sample with pole radii matched to the
+ *             Hann windows' weight. No window re-reads at all, so streaming
+ *             cost is spread perfectly evenly across callbacks instead of
+ *             spiking at each hop; the exponential window gives a slightly
+ *             different passband shape than librosa. The single-frame
+ *             extractor runs the bank causally over the supplied window.
+ */
+enum class CqtMethod {
+	TimeDomain,
+	SparseFft,
+	Multirate,
+	Resonator,
+};
+
+/**
+ * Kernel coefficient scalar
+ *
+ * Building with -DENGINE_CQT_FP16 stores the kernel planes in half precision,
+ * halving kernel footprint (~9.6MB -> ~4.8MB) and the memory traffic of the
+ * correlation loop, which is memory-bound on phone-class cores. Accumulation
+ * stays float32; the kernels are smooth windowed sinusoids, so the storage
+ * precision loss is far below the output tolerances. Requires a native half
+ * type (__fp16 on ARM, _Float16 elsewhere - GCC 12+/Clang 15+ on x86).
+ */
+#if defined(ENGINE_CQT_FP16)
+#if defined(__ARM_NEON) || defined(__ARM_FP16_FORMAT_IEEE)
+using CqtCoeff = __fp16;
+#else
+using CqtCoeff = _Float16;
+#endif
+#else
+using CqtCoeff = float;
+#endif
+
 /**
  * CQT Kernel
  *
  * Pre-computed complex exponential kernel for a single CQT bin.
  * Each bin has its own window length based on its center frequency.
+ *
+ * Coefficients are stored as separate real/imaginary planes (split-complex,
+ * structure-of-arrays) so the correlation inner loop vectorizes cleanly -
+ * NEON/AVX and vDSP all want contiguous same-component data.
  */
 struct CqtKernel {
-	float centerFreq;                           // Center frequency (Hz)
-	int filterLength;                           // Window length (samples)
-	std::vector<std::complex<float>> kernel;    // Complex exponential * window
+	float centerFreq;               // Center frequency (Hz)
+	int filterLength;               // Window length (samples)
+	std::vector<CqtCoeff> real;     // window[n] * cos(2*pi*f*n/sr)
+	std::vector<CqtCoeff> imag;     // window[n] * sin(2*pi*f*n/sr)
 };
 
 /**
@@ -61,7 +124,7 @@ struct CqtKernel {
  */
 class CqtExtractor {
 public:
-	CqtExtractor();
+	explicit CqtExtractor(CqtMethod method = CqtMethod::TimeDomain);
 	~CqtExtractor();
 
 	/** Reset state (call when starting a new audio stream) */
@@ -91,6 +154,17 @@ public:
 	/** Get maximum filter length needed */
 	static constexpr int getMaxFilterLength() { return CqtConfig::MAX_FILTER_LENGTH; }
 
+	/** Get evaluation method selected at construction */
+	CqtMethod getMethod() const;
+
+	/**
+	 * Set a directory for the serialized kernel cache (empty disables, the
+	 * default). When set, construction loads precomputed kernels from a
+	 * versioned binary blob in that directory instead of synthesizing them,
+	 * writing the blob on first run. Call before constructing extractors.
+	 */
+	static void setKernelCachePath(const std::string& dir);
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl_;
@@ -106,7 +180,7 @@ private:
  */
 class StreamingCqtExtractor {
 public:
-	StreamingCqtExtractor();
+	explicit StreamingCqtExtractor(CqtMethod method = CqtMethod::TimeDomain);
 	~StreamingCqtExtractor();
 
 	/** Reset state */
@@ -126,6 +200,12 @@ public:
 	/** Get total frames extracted so far */
 	int getFrameCount() const;
 
+	/** Serialize the audio ring (or resonator states) for Engine snapshots */
+	void saveState(StateWriter& w) const;
+
+	/** Restore a snapshot; the CQT method must match this instance */
+	bool loadState(StateReader& r);
+
 	/** Get number of output CQT bins per frame (105) */
 	static constexpr int getNumBins() { return CqtConfig::N_BINS; }
 
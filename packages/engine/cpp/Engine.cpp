@@ -3,11 +3,26 @@
  */
 
 #include "Engine.hpp"
+#include "StateBlob.hpp"
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace engine {
 
+// Microseconds elapsed since a steady_clock timestamp (telemetry helper)
+static uint64_t microsSince(std::chrono::steady_clock::time_point start) {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
 Engine::Engine()
 	: melExtractor_(std::make_unique<StreamingMelExtractor>())
 	, beatnetModel_(std::make_unique<OnnxModel>())
@@ -15,10 +30,20 @@ Engine::Engine()
 	, cqtExtractor_(std::make_unique<StreamingCqtExtractor>())
 	, keyModel_(std::make_unique<KeyModel>())
 {
-	// Pre-allocate 4-minute rolling CQT ring buffer (1200 frames at 5 FPS)
-	cqtBuffer_.resize(CqtConfig::N_BINS * KEY_MAX_FRAMES, 0.0f);
-	cqtScratch_.resize(CqtConfig::N_BINS * MAX_CQT_FRAMES_PER_PUSH, 0.0f);
-	cqtInferenceBuffer_.resize(CqtConfig::N_BINS * KEY_MAX_FRAMES, 0.0f);
+	// Carve all fixed-size pipeline scratch from one arena allocation.
+	// cqtBuffer_ is the 4-minute rolling CQT ring (1200 frames at 5 FPS),
+	// freq-major: row b holds bin b's history, so the inference window can
+	// be assembled with row-wise memcpys in the model's [freq][time] layout.
+	arena_.reserve(3 * CqtConfig::N_BINS * KEY_MAX_FRAMES +
+	               CqtConfig::N_BINS * MAX_CQT_FRAMES_PER_PUSH +
+	               KeyModel::NUM_CLASSES +
+	               DOWNMIX_CHUNK_FRAMES);
+	cqtBuffer_ = arena_.take(CqtConfig::N_BINS * KEY_MAX_FRAMES);
+	cqtScratch_ = arena_.take(CqtConfig::N_BINS * MAX_CQT_FRAMES_PER_PUSH);
+	keySnapshot_ = arena_.take(CqtConfig::N_BINS * KEY_MAX_FRAMES);
+	keyWorkBuffer_ = arena_.take(CqtConfig::N_BINS * KEY_MAX_FRAMES);
+	keyLogitSum_ = arena_.take(KeyModel::NUM_CLASSES);
+	downmixBuffer_ = arena_.take(DOWNMIX_CHUNK_FRAMES);
 
 	// Pre-allocate resample buffer (generous size for typical audio chunks)
 	resampleBuffer_.resize(44100);
@@ -27,7 +52,16 @@ Engine::Engine()
 	currentKey_ = {"", "", 0.0f, false};
 }
 
-Engine::~Engine() = default;
+Engine::~Engine() {
+	{
+		std::lock_guard<std::mutex> lock(keyMutex_);
+		keyWorkerStop_ = true;
+	}
+	keyCv_.notify_all();
+	if (keyWorker_.joinable()) {
+		keyWorker_.join();
+	}
+}
 
 void Engine::reset() {
 	// Reset BPM detection
@@ -37,26 +71,62 @@ void Engine::reset() {
 	}
 	activationBuffer_.clear();
 	resampler_->reset();
+	if (keyResampler_) {
+		keyResampler_->reset();
+	}
+
+	// Telemetry is session-scoped
+	resampleTimer_.clear();
+	melTimer_.clear();
+	beatnetTimer_.clear();
+	cqtTimer_.clear();
+	keyInferenceTimer_.clear();
+	bpmFramesProduced_.store(0, std::memory_order_relaxed);
 
-	// Reset key detection
+	// Reset key detection. Bumping the epoch makes the worker drop any
+	// result it is still computing from pre-reset audio.
 	cqtExtractor_->reset();
 	cqtHead_ = 0;
 	cqtFrameCount_ = 0;
 	cqtWindowFrameCount_ = 0;
 	cqtFramesSinceInference_ = 0;
 	keyInferenceCount_ = 0;
-	currentKey_ = {"", "", 0.0f, false};
+	keyInterval_ = KEY_INFERENCE_INTERVAL;
+	keyJobEverPosted_ = false;
+	lastSeenKeyInference_ = 0;
+	lastKeyCamelot_.clear();
+	cqtEnergyEma_ = 0.0f;
+	{
+		std::lock_guard<std::mutex> snapshotLock(keyMutex_);
+		std::lock_guard<std::mutex> resultLock(keyResultMutex_);
+		keyJobPending_ = false;
+		keySnapshotFrames_ = 0;
+		keySnapshotWeight_ = 0;
+		keyEpoch_++;
+		std::fill(keyLogitSum_, keyLogitSum_ + KeyModel::NUM_CLASSES, 0.0f);
+		keyLogitWeight_ = 0.0f;
+		currentKey_ = {"", "", 0.0f, false};
+	}
+
+	// Wait out any inference already in flight: the epoch bump only drops
+	// its result, while the worker still owns keyWorkBuffer_ and the model
+	// session until it goes idle. Callers that reuse either after reset()
+	// (analyzeBuffer) rely on this handshake.
+	{
+		std::unique_lock<std::mutex> lock(keyMutex_);
+		keyCv_.wait(lock, [this] { return !keyWorkerBusy_; });
+	}
 }
 
 // =============================================================================
 // BPM Detection (BeatNet)
 // =============================================================================
 
-bool Engine::loadModel(const std::string& modelPath) {
+bool Engine::loadModel(const std::string& modelPath, ModelPrecision precision) {
 	if (!beatnetModel_) {
 		beatnetModel_ = std::make_unique<OnnxModel>();
 	}
-	return beatnetModel_->load(modelPath);
+	return beatnetModel_->load(modelPath, precision);
 }
 
 bool Engine::isReady() const {
@@ -96,17 +166,25 @@ size_t Engine::getFrameCount() const {
 // Key Detection (MusicalKeyCNN)
 // =============================================================================
 
-bool Engine::loadKeyModel(const std::string& modelPath) {
+bool Engine::loadKeyModel(const std::string& modelPath, ModelPrecision precision) {
 	if (!keyModel_) {
 		keyModel_ = std::make_unique<KeyModel>();
 	}
-	return keyModel_->load(modelPath);
+	if (!keyModel_->load(modelPath, precision)) {
+		return false;
+	}
+	ensureKeyWorker();
+	return true;
 }
 
 bool Engine::isKeyReady() const {
 	return keyModel_ && keyModel_->isReady();
 }
 
+void Engine::setCqtMethod(CqtMethod method) {
+	cqtExtractor_ = std::make_unique<StreamingCqtExtractor>(method);
+}
+
 bool Engine::warmUpKey() {
 	if (!isKeyReady()) {
 		return false;
@@ -124,6 +202,7 @@ bool Engine::warmUpKey() {
 }
 
 Engine::KeyResult Engine::getKey() const {
+	std::lock_guard<std::mutex> lock(keyResultMutex_);
 	return currentKey_;
 }
 
@@ -131,71 +210,485 @@ size_t Engine::getKeyFrameCount() const {
 	return cqtFrameCount_;
 }
 
+// =============================================================================
+// State Snapshot
+// =============================================================================
+
+// Blob framing: "KEYS" magic plus a version bumped on any layout change, so
+// a blob from an incompatible build is rejected before any state is touched
+static constexpr uint32_t STATE_MAGIC = 0x4B455953;
+static constexpr uint32_t STATE_VERSION = 1;
+
+void Engine::serialize(std::vector<uint8_t>& out) const {
+	out.clear();
+	StateWriter w(out);
+	w.write(STATE_MAGIC);
+	w.write(STATE_VERSION);
+	w.write(static_cast<int32_t>(inputRate_));
+
+	// BPM branch: mel buffers, resampler histories, activation rings
+	melExtractor_->saveState(w);
+	resampler_->saveState(w);
+	w.write(static_cast<uint8_t>(keyResampler_ ? 1 : 0));
+	if (keyResampler_) {
+		keyResampler_->saveState(w);
+	}
+	activationBuffer_.saveState(w);
+
+	// BeatNet LSTM state. Flag-gated so a snapshot taken before the model
+	// loads still restores cleanly.
+	std::vector<float> hidden, cell;
+	const bool hasLstm = beatnetModel_ && beatnetModel_->getLstmState(hidden, cell);
+	w.write(static_cast<uint8_t>(hasLstm ? 1 : 0));
+	if (hasLstm) {
+		w.write(static_cast<uint32_t>(hidden.size()));
+		w.write(static_cast<uint32_t>(cell.size()));
+		w.writeFloats(hidden.data(), hidden.size());
+		w.writeFloats(cell.data(), cell.size());
+	}
+
+	// Key branch: CQT extractor, rolling ring and its counters
+	cqtExtractor_->saveState(w);
+	w.writeFloats(cqtBuffer_, static_cast<size_t>(CqtConfig::N_BINS) * KEY_MAX_FRAMES);
+	w.write(static_cast<uint64_t>(cqtHead_));
+	w.write(static_cast<uint64_t>(cqtFrameCount_));
+	w.write(static_cast<uint64_t>(cqtWindowFrameCount_));
+	w.write(static_cast<uint64_t>(cqtFramesSinceInference_));
+	w.write(static_cast<uint64_t>(keyInterval_));
+	w.write(cqtEnergyEma_);
+	w.writeString(lastKeyCamelot_);
+
+	// Incremental pooling state and the published result
+	{
+		std::lock_guard<std::mutex> lock(keyResultMutex_);
+		w.writeFloats(keyLogitSum_, KeyModel::NUM_CLASSES);
+		w.write(keyLogitWeight_);
+		w.writeString(currentKey_.camelot);
+		w.writeString(currentKey_.notation);
+		w.write(currentKey_.confidence);
+		w.write(static_cast<uint8_t>(currentKey_.valid ? 1 : 0));
+	}
+}
+
+bool Engine::restore(const uint8_t* data, size_t size) {
+	StateReader r(data, size);
+	bool ok = r.expect(STATE_MAGIC) &&
+	          r.expect(STATE_VERSION) &&
+	          r.expect(static_cast<int32_t>(inputRate_));
+
+	ok = ok && melExtractor_->loadState(r);
+	ok = ok && resampler_->loadState(r);
+	ok = ok && r.expect(static_cast<uint8_t>(keyResampler_ ? 1 : 0));
+	if (ok && keyResampler_) {
+		ok = keyResampler_->loadState(r);
+	}
+	ok = ok && activationBuffer_.loadState(r);
+
+	// LSTM state is applied only when a model is loaded here too; otherwise
+	// it is consumed and discarded so the rest of the blob still lines up
+	uint8_t hasLstm = 0;
+	ok = ok && r.read(hasLstm);
+	if (ok && hasLstm) {
+		uint32_t hiddenSize = 0;
+		uint32_t cellSize = 0;
+		std::vector<float> hidden, cell;
+		ok = r.read(hiddenSize) && r.read(cellSize);
+		if (ok) {
+			hidden.resize(hiddenSize);
+			cell.resize(cellSize);
+			ok = r.readFloats(hidden.data(), hiddenSize) &&
+			     r.readFloats(cell.data(), cellSize);
+		}
+		if (ok && isReady()) {
+			ok = beatnetModel_->setLstmState(hidden, cell);
+		}
+	}
+
+	ok = ok && cqtExtractor_->loadState(r);
+	ok = ok && r.readFloats(cqtBuffer_,
+	                        static_cast<size_t>(CqtConfig::N_BINS) * KEY_MAX_FRAMES);
+
+	uint64_t head = 0, frameCount = 0, windowCount = 0, sinceInference = 0, interval = 0;
+	ok = ok && r.read(head) && r.read(frameCount) && r.read(windowCount) &&
+	     r.read(sinceInference) && r.read(interval);
+	ok = ok && head < KEY_MAX_FRAMES && windowCount <= KEY_MAX_FRAMES &&
+	     interval >= KEY_INFERENCE_INTERVAL && interval <= KEY_MAX_INFERENCE_INTERVAL;
+	if (ok) {
+		cqtHead_ = static_cast<size_t>(head);
+		cqtFrameCount_ = static_cast<size_t>(frameCount);
+		cqtWindowFrameCount_ = static_cast<size_t>(windowCount);
+		cqtFramesSinceInference_ = static_cast<size_t>(sinceInference);
+		keyInterval_ = static_cast<size_t>(interval);
+	}
+	ok = ok && r.read(cqtEnergyEma_) && r.readString(lastKeyCamelot_);
+
+	if (ok) {
+		std::lock_guard<std::mutex> lock(keyResultMutex_);
+		uint8_t valid = 0;
+		ok = r.readFloats(keyLogitSum_, KeyModel::NUM_CLASSES) &&
+		     r.read(keyLogitWeight_) &&
+		     r.readString(currentKey_.camelot) &&
+		     r.readString(currentKey_.notation) &&
+		     r.read(currentKey_.confidence) &&
+		     r.read(valid);
+		currentKey_.valid = valid != 0;
+	}
+
+	// A published result counts as already observed by the cadence logic,
+	// and a window past the minimum has already had its first job posted
+	lastSeenKeyInference_ = keyInferenceCount_.load();
+	keyJobEverPosted_ = cqtFrameCount_ >= KEY_MIN_FRAMES;
+
+	if (!ok || !r.atEnd()) {
+		reset();
+		return false;
+	}
+	return true;
+}
+
+// =============================================================================
+// Telemetry
+// =============================================================================
+
+Engine::Stats Engine::getStats() const {
+	Stats stats;
+	stats.resample = resampleTimer_.snapshot();
+	stats.mel = melTimer_.snapshot();
+	stats.beatnet = beatnetTimer_.snapshot();
+	stats.cqt = cqtTimer_.snapshot();
+	stats.keyInference = keyInferenceTimer_.snapshot();
+	stats.bpmFrames = bpmFramesProduced_.load(std::memory_order_relaxed);
+	stats.cqtFrames = cqtFrameCount_;
+	stats.keyInferences = static_cast<uint64_t>(keyInferenceCount_.load());
+	return stats;
+}
+
+void Engine::ensureKeyWorker() {
+	if (keyWorker_.joinable()) {
+		return;
+	}
+	keyWorker_ = std::thread(&Engine::keyWorkerLoop, this);
+}
+
+void Engine::keyWorkerLoop() {
+	for (;;) {
+		int frames = 0;
+		int weight = 0;
+		uint64_t epoch = 0;
+		{
+			std::unique_lock<std::mutex> lock(keyMutex_);
+			keyCv_.wait(lock, [this] { return keyJobPending_ || keyWorkerStop_; });
+			if (keyWorkerStop_) {
+				return;
+			}
+			keyJobPending_ = false;
+			keyWorkerBusy_ = true;
+			frames = keySnapshotFrames_;
+			weight = keySnapshotWeight_;
+			epoch = keyEpoch_;
+			std::swap(keySnapshot_, keyWorkBuffer_);
+		}
+
+		KeyOutput output;
+		float chunkLogits[KeyModel::NUM_CLASSES];
+		const auto inferStart = std::chrono::steady_clock::now();
+		const bool inferred = keyModel_->inferVariable(keyWorkBuffer_, frames, output, chunkLogits);
+		keyInferenceTimer_.add(microsSince(inferStart));
+		if (inferred) {
+			foldKeyResult(epoch, weight, chunkLogits);
+		}
+
+		// Idle again: reset() may be waiting to reclaim keyWorkBuffer_ and
+		// the model session
+		{
+			std::lock_guard<std::mutex> lock(keyMutex_);
+			keyWorkerBusy_ = false;
+		}
+		keyCv_.notify_all();
+	}
+}
+
+void Engine::foldKeyResult(uint64_t epoch, int weight, const float* chunkLogits) {
+	std::lock_guard<std::mutex> lock(keyResultMutex_);
+	if (epoch != keyEpoch_) {
+		// reset() ran while we were inferring; drop the stale result
+		return;
+	}
+
+	// Fold the chunk into the frame-weighted logit average, capping the
+	// accumulated weight so old chunks decay on a 4-minute horizon
+	const float w = static_cast<float>(weight);
+	for (int c = 0; c < KeyModel::NUM_CLASSES; c++) {
+		keyLogitSum_[c] += chunkLogits[c] * w;
+	}
+	keyLogitWeight_ += w;
+	if (keyLogitWeight_ > static_cast<float>(KEY_MAX_FRAMES)) {
+		const float scale = static_cast<float>(KEY_MAX_FRAMES) / keyLogitWeight_;
+		for (int c = 0; c < KeyModel::NUM_CLASSES; c++) {
+			keyLogitSum_[c] *= scale;
+		}
+		keyLogitWeight_ = static_cast<float>(KEY_MAX_FRAMES);
+	}
+
+	// Never pool over zero weight: 0/0 would publish NaN as a valid key
+	if (keyLogitWeight_ <= 0.0f) {
+		return;
+	}
+
+	float pooledLogits[KeyModel::NUM_CLASSES];
+	for (int c = 0; c < KeyModel::NUM_CLASSES; c++) {
+		pooledLogits[c] = keyLogitSum_[c] / keyLogitWeight_;
+	}
+	KeyOutput pooled;
+	KeyModel::classify(pooledLogits, pooled);
+
+	keyInferenceCount_++;
+	currentKey_.camelot = pooled.camelot;
+	currentKey_.notation = pooled.notation;
+	currentKey_.confidence = pooled.confidence;
+	currentKey_.valid = true;
+}
+
 void Engine::runKeyInference() {
 	if (!isKeyReady() || cqtFrameCount_ < KEY_MIN_FRAMES || cqtWindowFrameCount_ == 0) {
 		return;
 	}
 
-	const int bins = CqtConfig::N_BINS;
-	const int frames = static_cast<int>(cqtWindowFrameCount_);
-	const float* input = cqtBuffer_.data();
+	const size_t bins = CqtConfig::N_BINS;
 
-	if (cqtWindowFrameCount_ == KEY_MAX_FRAMES) {
-		for (size_t i = 0; i < KEY_MAX_FRAMES; i++) {
-			size_t src = (cqtHead_ + i) % KEY_MAX_FRAMES;
-			const float* srcFrame = &cqtBuffer_[src * bins];
-			float* dstFrame = &cqtInferenceBuffer_[i * bins];
-			std::copy(srcFrame, srcFrame + bins, dstFrame);
+	// Only the frames accumulated since the last scheduled inference need a
+	// CNN pass (the first inference covers the whole window); overlap frames
+	// re-supply conv context at the seam and carry no pooling weight.
+	const size_t newFrames = std::min(cqtFramesSinceInference_, cqtWindowFrameCount_);
+	if (newFrames == 0) {
+		// Nothing new to fold in - and because posts coalesce, a zero-weight
+		// re-post would overwrite a still-pending job's snapshot
+		return;
+	}
+	const size_t chunkFrames = std::min(newFrames + KEY_CHUNK_OVERLAP, cqtWindowFrameCount_);
+
+	// Assemble the chunk in the model's [freq][time] layout - one row per
+	// bin, at most two memcpys per row around the ring wrap - and hand it to
+	// the worker; the caller returns immediately while the CNN runs off the
+	// audio path.
+	{
+		std::lock_guard<std::mutex> lock(keyMutex_);
+		const size_t firstOrdinal = cqtWindowFrameCount_ - chunkFrames;
+		const size_t startCol = cqtWindowFrameCount_ == KEY_MAX_FRAMES
+			? (cqtHead_ + firstOrdinal) % KEY_MAX_FRAMES
+			: firstOrdinal;
+		const size_t first = std::min(chunkFrames, KEY_MAX_FRAMES - startCol);
+
+		for (size_t b = 0; b < bins; b++) {
+			const float* row = &cqtBuffer_[b * KEY_MAX_FRAMES];
+			float* dst = &keySnapshot_[b * chunkFrames];
+			std::memcpy(dst, row + startCol, first * sizeof(float));
+			if (first < chunkFrames) {
+				std::memcpy(dst + first, row, (chunkFrames - first) * sizeof(float));
+			}
 		}
-		input = cqtInferenceBuffer_.data();
+		keySnapshotFrames_ = static_cast<int>(chunkFrames);
+		keySnapshotWeight_ = static_cast<int>(newFrames);
+		keyJobPending_ = true;
 	}
+	keyCv_.notify_one();
 
-	KeyOutput output;
-	if (keyModel_->inferVariable(input, frames, output)) {
-		keyInferenceCount_++;
-		cqtFramesSinceInference_ = 0;
-		currentKey_.camelot = output.camelot;
-		currentKey_.notation = output.notation;
-		currentKey_.confidence = output.confidence;
-		currentKey_.valid = true;
+	keyJobEverPosted_ = true;
+	cqtFramesSinceInference_ = 0;
+}
+
+// =============================================================================
+// Multichannel Downmix
+// =============================================================================
+
+/**
+ * Equal-weight mono downmix of interleaved frames.
+ *
+ * The stereo case gets a dedicated path: deinterleave-and-average maps onto
+ * strided vDSP ops and NEON's vld2q, and stereo is what the mobile capture
+ * paths actually deliver. The generic path is a plain scalar loop; beyond
+ * two channels the input is already off the hot capture path.
+ */
+static void downmixInterleaved(const float* in, int frames, int channels, float* out) {
+	if (channels == 2) {
+#if defined(__APPLE__)
+		float half = 0.5f;
+		vDSP_vadd(in, 2, in + 1, 2, out, 1, static_cast<vDSP_Length>(frames));
+		vDSP_vsmul(out, 1, &half, out, 1, static_cast<vDSP_Length>(frames));
+#elif defined(__ARM_NEON)
+		const float32x4_t half = vdupq_n_f32(0.5f);
+		int i = 0;
+		for (; i + 4 <= frames; i += 4) {
+			float32x4x2_t lr = vld2q_f32(in + 2 * i);
+			vst1q_f32(out + i, vmulq_f32(vaddq_f32(lr.val[0], lr.val[1]), half));
+		}
+		for (; i < frames; i++) {
+			out[i] = 0.5f * (in[2 * i] + in[2 * i + 1]);
+		}
+#else
+		for (int i = 0; i < frames; i++) {
+			out[i] = 0.5f * (in[2 * i] + in[2 * i + 1]);
+		}
+#endif
+		return;
+	}
+	const float scale = 1.0f / static_cast<float>(channels);
+	for (int i = 0; i < frames; i++) {
+		const float* frame = in + static_cast<size_t>(i) * channels;
+		float sum = 0.0f;
+		for (int c = 0; c < channels; c++) {
+			sum += frame[c];
+		}
+		out[i] = sum * scale;
 	}
 }
 
+/**
+ * Equal-weight mono downmix of planar channels, reading each channel at
+ * the given frame offset. Contiguous per-channel reads vectorize directly.
+ */
+static void downmixPlanar(const float* const* channels, int numChannels,
+                          int offset, int frames, float* out) {
+	const float scale = 1.0f / static_cast<float>(numChannels);
+#if defined(__APPLE__)
+	vDSP_vsmul(channels[0] + offset, 1, &scale, out, 1, static_cast<vDSP_Length>(frames));
+	for (int c = 1; c < numChannels; c++) {
+		vDSP_vsma(channels[c] + offset, 1, &scale, out, 1, out, 1,
+		          static_cast<vDSP_Length>(frames));
+	}
+#else
+	std::memcpy(out, channels[0] + offset, frames * sizeof(float));
+	for (int c = 1; c < numChannels; c++) {
+		const float* src = channels[c] + offset;
+#if defined(__ARM_NEON)
+		int i = 0;
+		for (; i + 4 <= frames; i += 4) {
+			vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vld1q_f32(src + i)));
+		}
+		for (; i < frames; i++) {
+			out[i] += src[i];
+		}
+#else
+		for (int i = 0; i < frames; i++) {
+			out[i] += src[i];
+		}
+#endif
+	}
+	for (int i = 0; i < frames; i++) {
+		out[i] *= scale;
+	}
+#endif
+}
+
 // =============================================================================
 // Audio Processing
 // =============================================================================
 
+bool Engine::setInputSampleRate(int rate) {
+	if (rate < SAMPLE_RATE) {
+		return false;
+	}
+	inputRate_ = rate;
+	resampler_ = std::make_unique<Resampler>(rate, BPM_SAMPLE_RATE);
+	keyResampler_ = rate == SAMPLE_RATE
+		? nullptr
+		: std::make_unique<Resampler>(rate, SAMPLE_RATE);
+	if (keyResampler_) {
+		// Pre-allocate like resampleBuffer_ (setup time, off the hot path)
+		keyResampleBuffer_.resize(rate);
+	}
+	return true;
+}
+
 int Engine::processAudio(const float* samples, int numSamples,
                          FrameResult* outResults, int maxResults) {
 	// -------------------------------------------------------------------------
 	// Key Detection Pipeline (44100 Hz)
 	// -------------------------------------------------------------------------
 	if (isKeyReady()) {
-		int cqtProduced = cqtExtractor_->push(samples, numSamples,
-		                                       cqtScratch_.data(), MAX_CQT_FRAMES_PER_PUSH);
+		// Non-native capture rates are converted here in a single rational
+		// pass; the BPM branch below resamples from the raw input itself
+		const float* keySamples = samples;
+		int keyCount = numSamples;
+		if (keyResampler_) {
+			int maxKey = keyResampler_->getOutputSize(numSamples) + 64;
+			if (maxKey > static_cast<int>(keyResampleBuffer_.size())) {
+				keyResampleBuffer_.resize(maxKey);
+			}
+			const auto keyResampleStart = std::chrono::steady_clock::now();
+			keyCount = keyResampler_->processStreaming(samples, numSamples,
+			                                            keyResampleBuffer_.data(), maxKey);
+			resampleTimer_.add(microsSince(keyResampleStart));
+			keySamples = keyResampleBuffer_.data();
+		}
+
+		const auto cqtStart = std::chrono::steady_clock::now();
+		int cqtProduced = cqtExtractor_->push(keySamples, keyCount,
+		                                       cqtScratch_, MAX_CQT_FRAMES_PER_PUSH);
+		cqtTimer_.add(microsSince(cqtStart));
 
 		// Append CQT frames into a fixed 4-minute rolling ring window.
 		const size_t bins = static_cast<size_t>(CqtConfig::N_BINS);
 		for (int i = 0; i < cqtProduced; i++) {
 			const float* src = &cqtScratch_[i * CqtConfig::N_BINS];
+
+			// Track the per-frame energy profile; a sharp swing means a
+			// track transition, so snap the cadence back to fast
+			float energy = 0.0f;
+			for (size_t b = 0; b < bins; b++) {
+				energy += src[b];
+			}
+			if (cqtEnergyEma_ > 0.0f &&
+			    std::fabs(energy - cqtEnergyEma_) > KEY_ENERGY_SHIFT_RATIO * cqtEnergyEma_) {
+				keyInterval_ = KEY_INFERENCE_INTERVAL;
+			}
+			cqtEnergyEma_ = cqtEnergyEma_ == 0.0f
+				? energy
+				: cqtEnergyEma_ + KEY_ENERGY_EMA_ALPHA * (energy - cqtEnergyEma_);
+
+			// Scatter the frame down the freq-major ring: one column write
+			// per bin row
 			if (cqtWindowFrameCount_ < KEY_MAX_FRAMES) {
-				float* dst = &cqtBuffer_[cqtWindowFrameCount_ * CqtConfig::N_BINS];
-				std::copy(src, src + CqtConfig::N_BINS, dst);
+				const size_t col = cqtWindowFrameCount_;
+				for (size_t b = 0; b < bins; b++) {
+					cqtBuffer_[b * KEY_MAX_FRAMES + col] = src[b];
+				}
 				cqtWindowFrameCount_++;
 				cqtHead_ = cqtWindowFrameCount_ % KEY_MAX_FRAMES;
 			} else {
-				float* dst = &cqtBuffer_[cqtHead_ * bins];
-				std::copy(src, src + CqtConfig::N_BINS, dst);
+				for (size_t b = 0; b < bins; b++) {
+					cqtBuffer_[b * KEY_MAX_FRAMES + cqtHead_] = src[b];
+				}
 				cqtHead_ = (cqtHead_ + 1) % KEY_MAX_FRAMES;
 			}
 			cqtFrameCount_++;
 			cqtFramesSinceInference_++;
 		}
 
-		// Run inference when we have minimum frames, then every N new frames
+		// Observe any newly published result and adapt the cadence: back off
+		// exponentially while consecutive answers agree with high confidence,
+		// snap back when the key changes or confidence drops
+		const int published = keyInferenceCount_.load();
+		if (published != lastSeenKeyInference_) {
+			lastSeenKeyInference_ = published;
+			KeyResult latest = getKey();
+			if (latest.valid && latest.confidence >= KEY_CONFIDENCE_THRESHOLD &&
+			    latest.camelot == lastKeyCamelot_) {
+				keyInterval_ = std::min<size_t>(keyInterval_ * 2, KEY_MAX_INFERENCE_INTERVAL);
+			} else {
+				keyInterval_ = KEY_INFERENCE_INTERVAL;
+			}
+			lastKeyCamelot_ = latest.camelot;
+		}
+
+		// Run inference when we have minimum frames, then every interval.
+		// "First job posted" gates the initial window, not "first result
+		// published": the first async inference takes many processAudio
+		// calls to land, and re-posting every call until then would queue
+		// pointless jobs over the same window.
 		bool hasMinFrames = cqtFrameCount_ >= KEY_MIN_FRAMES;
 		bool shouldRunInference = hasMinFrames &&
-			(keyInferenceCount_ == 0 || cqtFramesSinceInference_ >= KEY_INFERENCE_INTERVAL);
+			(!keyJobEverPosted_ || cqtFramesSinceInference_ >= keyInterval_);
 
 		if (shouldRunInference) {
 			runKeyInference();
@@ -203,7 +696,7 @@ int Engine::processAudio(const float* samples, int numSamples,
 	}
 
 	// -------------------------------------------------------------------------
-	// BPM Detection Pipeline (resample 44100 -> 22050 Hz)
+	// BPM Detection Pipeline (resample input rate -> 22050 Hz)
 	// -------------------------------------------------------------------------
 	if (!isReady()) {
 		return 0;
@@ -215,13 +708,154 @@ int Engine::processAudio(const float* samples, int numSamples,
 		resampleBuffer_.resize(maxOutput);
 	}
 
+	const auto resampleStart = std::chrono::steady_clock::now();
 	int actualResampled = resampler_->processStreaming(samples, numSamples,
 	                                                    resampleBuffer_.data(), maxOutput);
+	resampleTimer_.add(microsSince(resampleStart));
 
 	// Process resampled audio through BPM pipeline
 	return processAudioForBpm(resampleBuffer_.data(), actualResampled, outResults, maxResults);
 }
 
+int Engine::processAudioInterleaved(const float* samples, int numFrames, int numChannels,
+                                    FrameResult* outResults, int maxResults) {
+	if (numChannels <= 1) {
+		return processAudio(samples, numFrames, outResults, maxResults);
+	}
+
+	// Downmix one chunk at a time and push it through the mono path while
+	// the mix is still in cache
+	int total = 0;
+	for (int offset = 0; offset < numFrames; offset += DOWNMIX_CHUNK_FRAMES) {
+		const int chunk = std::min(DOWNMIX_CHUNK_FRAMES, numFrames - offset);
+		downmixInterleaved(samples + static_cast<size_t>(offset) * numChannels,
+		                   chunk, numChannels, downmixBuffer_);
+		total += processAudio(downmixBuffer_, chunk,
+		                      outResults ? outResults + total : nullptr,
+		                      std::max(maxResults - total, 0));
+	}
+	return total;
+}
+
+int Engine::processAudioPlanar(const float* const* channels, int numFrames, int numChannels,
+                               FrameResult* outResults, int maxResults) {
+	if (numChannels <= 1) {
+		return processAudio(channels[0], numFrames, outResults, maxResults);
+	}
+
+	int total = 0;
+	for (int offset = 0; offset < numFrames; offset += DOWNMIX_CHUNK_FRAMES) {
+		const int chunk = std::min(DOWNMIX_CHUNK_FRAMES, numFrames - offset);
+		downmixPlanar(channels, numChannels, offset, chunk, downmixBuffer_);
+		total += processAudio(downmixBuffer_, chunk,
+		                      outResults ? outResults + total : nullptr,
+		                      std::max(maxResults - total, 0));
+	}
+	return total;
+}
+
+// =============================================================================
+// Offline Analysis
+// =============================================================================
+
+Engine::AnalysisResult Engine::analyzeBuffer(const float* samples, size_t numSamples) {
+	AnalysisResult result;
+	result.bpm = 0.0f;
+	result.key = {"", "", 0.0f, false};
+	if (!samples || numSamples == 0) {
+		return result;
+	}
+
+	reset();
+
+	// Key branch on its own thread. It owns cqtExtractor_, cqtBuffer_ and
+	// keyWorkBuffer_ for the duration; the BPM branch below never touches
+	// them, no job is posted here, and reset() above waited for any
+	// in-flight streaming inference, so the key worker stays idle.
+	std::thread keyThread;
+	if (isKeyReady()) {
+		keyThread = std::thread([this, samples, numSamples, &result] {
+			const size_t bins = static_cast<size_t>(CqtConfig::N_BINS);
+
+			// Feed the extractor in chunks sized so cqtScratch_ can never
+			// overflow, scattering frames down the freq-major ring exactly as
+			// the streaming path does (minus the cadence bookkeeping)
+			constexpr size_t CHUNK = static_cast<size_t>(CqtConfig::HOP_LENGTH) *
+			                         MAX_CQT_FRAMES_PER_PUSH;
+			for (size_t offset = 0; offset < numSamples; offset += CHUNK) {
+				const int chunk = static_cast<int>(std::min(CHUNK, numSamples - offset));
+				const int produced = cqtExtractor_->push(
+					samples + offset, chunk, cqtScratch_, MAX_CQT_FRAMES_PER_PUSH);
+
+				for (int i = 0; i < produced; i++) {
+					const float* src = &cqtScratch_[i * CqtConfig::N_BINS];
+					const size_t col = cqtWindowFrameCount_ < KEY_MAX_FRAMES
+						? cqtWindowFrameCount_
+						: cqtHead_;
+					for (size_t b = 0; b < bins; b++) {
+						cqtBuffer_[b * KEY_MAX_FRAMES + col] = src[b];
+					}
+					if (cqtWindowFrameCount_ < KEY_MAX_FRAMES) {
+						cqtWindowFrameCount_++;
+						cqtHead_ = cqtWindowFrameCount_ % KEY_MAX_FRAMES;
+					} else {
+						cqtHead_ = (cqtHead_ + 1) % KEY_MAX_FRAMES;
+					}
+					cqtFrameCount_++;
+				}
+			}
+
+			const size_t frames = cqtWindowFrameCount_;
+			if (frames < static_cast<size_t>(KEY_MIN_FRAMES)) {
+				return;
+			}
+
+			// Linearize the final window into [freq][time] and run the CNN
+			// once - no incremental chunking or logit pooling needed offline
+			const size_t startCol = frames == KEY_MAX_FRAMES ? cqtHead_ : 0;
+			const size_t first = std::min(frames, KEY_MAX_FRAMES - startCol);
+			for (size_t b = 0; b < bins; b++) {
+				const float* row = &cqtBuffer_[b * KEY_MAX_FRAMES];
+				float* dst = &keyWorkBuffer_[b * frames];
+				std::memcpy(dst, row + startCol, first * sizeof(float));
+				if (first < frames) {
+					std::memcpy(dst + first, row, (frames - first) * sizeof(float));
+				}
+			}
+
+			KeyOutput output;
+			if (keyModel_->inferVariable(keyWorkBuffer_, static_cast<int>(frames), output)) {
+				result.key.camelot = output.camelot;
+				result.key.notation = output.notation;
+				result.key.confidence = output.confidence;
+				result.key.valid = true;
+			}
+		});
+	}
+
+	// BPM branch on the calling thread: resample -> mel -> batched BeatNet,
+	// in chunks that keep the resample buffer at its pre-allocated size
+	if (isReady()) {
+		constexpr size_t CHUNK = 1 << 15;
+		for (size_t offset = 0; offset < numSamples; offset += CHUNK) {
+			const int chunk = static_cast<int>(std::min(CHUNK, numSamples - offset));
+			const int maxOutput = resampler_->getOutputSize(chunk) + 64;
+			if (maxOutput > static_cast<int>(resampleBuffer_.size())) {
+				resampleBuffer_.resize(maxOutput);
+			}
+			const int resampled = resampler_->processStreaming(
+				samples + offset, chunk, resampleBuffer_.data(), maxOutput);
+			processAudioForBpm(resampleBuffer_.data(), resampled, nullptr, 0);
+		}
+		result.bpm = activationBuffer_.estimateBpm();
+	}
+
+	if (keyThread.joinable()) {
+		keyThread.join();
+	}
+	return result;
+}
+
 int Engine::processAudioForBpm(const float* samples, int numSamples,
                                FrameResult* outResults, int maxResults) {
 	if (!isReady()) {
@@ -239,24 +873,31 @@ int Engine::processAudioForBpm(const float* samples, int numSamples,
 
 	for (int offset = 0; offset < numSamples; offset += MAX_CHUNK_SAMPLES) {
 		const int chunk = std::min(MAX_CHUNK_SAMPLES, numSamples - offset);
+		const auto melStart = std::chrono::steady_clock::now();
 		const int numFrames = melExtractor_->push(
 			samples + offset, chunk, features, MAX_FRAMES
 		);
+		melTimer_.add(microsSince(melStart));
 		if (numFrames == 0) {
 			continue;
 		}
 
-		for (int i = 0; i < numFrames; i++) {
-			float* frameFeatures = &features[i * FEATURE_DIM];
-			ModelOutput modelOutput;
-			if (!beatnetModel_->infer(frameFeatures, modelOutput)) {
-				continue;
-			}
+		// One batched Run per chunk: the LSTM state carries across the
+		// sequence exactly as it would frame-by-frame
+		ModelOutput modelOutputs[MAX_FRAMES];
+		const auto beatnetStart = std::chrono::steady_clock::now();
+		const bool inferred = beatnetModel_->inferSequence(features, numFrames, modelOutputs);
+		beatnetTimer_.add(microsSince(beatnetStart));
+		if (!inferred) {
+			continue;
+		}
 
-			const float currBeatAct = modelOutput.beatActivation;
-			const float currDownAct = modelOutput.downbeatActivation;
+		for (int i = 0; i < numFrames; i++) {
+			const float currBeatAct = modelOutputs[i].beatActivation;
+			const float currDownAct = modelOutputs[i].downbeatActivation;
 			activationBuffer_.push(currBeatAct, currDownAct);
 			totalProduced++;
+			bpmFramesProduced_.fetch_add(1, std::memory_order_relaxed);
 
 			if (outResults && resultsProduced < maxResults) {
 				FrameResult& result = outResults[resultsProduced];
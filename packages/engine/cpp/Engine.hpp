@@ -6,8 +6,14 @@
 #include "KeyModel.hpp"
 #include "Resampler.hpp"
 #include "AutocorrBpm.hpp"
+#include "ScratchArena.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace engine {
@@ -47,9 +53,12 @@ public:
 	/**
 	 * Load BeatNet ONNX model
 	 * @param modelPath Path to beatnet.onnx model file
+	 * @param precision Model precision; Auto picks a quantized variant
+	 *                  (beatnet.int8.onnx) on ARM when one is shipped
 	 * @return true if loaded successfully
 	 */
-	bool loadModel(const std::string& modelPath);
+	bool loadModel(const std::string& modelPath,
+	               ModelPrecision precision = ModelPrecision::Auto);
 
 	/**
 	 * Check if BeatNet model is loaded and ready
@@ -86,15 +95,28 @@ public:
 	/**
 	 * Load MusicalKeyCNN ONNX model
 	 * @param modelPath Path to keynet.onnx model file
+	 * @param precision Model precision; Auto picks a quantized variant
+	 *                  (keynet.int8.onnx) on ARM when one is shipped
 	 * @return true if loaded successfully
 	 */
-	bool loadKeyModel(const std::string& modelPath);
+	bool loadKeyModel(const std::string& modelPath,
+	                  ModelPrecision precision = ModelPrecision::Auto);
 
 	/**
 	 * Check if MusicalKeyCNN model is loaded and ready
 	 */
 	bool isKeyReady() const;
 
+	/**
+	 * Select the streaming CQT evaluation method (default TimeDomain)
+	 *
+	 * Resonator spreads CQT work evenly across audio callbacks instead of
+	 * spiking at each hop, at the cost of a slightly different passband
+	 * shape than librosa's. Recreates the extractor, so call before
+	 * streaming audio.
+	 */
+	void setCqtMethod(CqtMethod method);
+
 	/**
 	 * Warm-up MusicalKeyCNN inference
 	 */
@@ -125,10 +147,24 @@ public:
 	// =========================================================================
 
 	/**
-	 * Process audio at 44100 Hz (native sample rate)
+	 * Set the capture sample rate for streaming input (default 44100)
+	 *
+	 * With a 48000 Hz capture device each branch gets its target rate in
+	 * one filtering pass: a rational 147:160 resampler feeds the key
+	 * branch at 44100 Hz and a 147:320 resampler feeds the BPM branch at
+	 * 22050 Hz directly, instead of a host-side conversion cascading into
+	 * the 2:1 resampler. Resets resampler state; call before streaming.
+	 *
+	 * @param rate Capture rate in Hz (must be >= 44100)
+	 * @return false if the rate is not supported
+	 */
+	bool setInputSampleRate(int rate);
+
+	/**
+	 * Process audio at the configured input rate (44100 Hz by default)
 	 * Handles both BPM detection (via resampling) and key detection
 	 *
-	 * @param samples Audio samples at 44100Hz
+	 * @param samples Audio samples at the input rate
 	 * @param numSamples Number of samples
 	 * @param outResults Output buffer for BPM frame results (optional, can be nullptr)
 	 * @param maxResults Maximum BPM results to output
@@ -137,6 +173,29 @@ public:
 	int processAudio(const float* samples, int numSamples,
 	                 FrameResult* outResults, int maxResults);
 
+	/**
+	 * Process interleaved multichannel audio at 44100 Hz
+	 *
+	 * Channels are downmixed to mono (equal weights) in cache-sized chunks
+	 * and fed straight into processAudio, so the mix is still hot when the
+	 * CQT extractor and resampler read it. numChannels == 1 forwards to
+	 * processAudio directly.
+	 *
+	 * @param samples Interleaved samples, numFrames * numChannels floats
+	 * @param numFrames Number of frames (samples per channel)
+	 * @param numChannels Number of interleaved channels (>= 1)
+	 * @return Number of BPM results produced
+	 */
+	int processAudioInterleaved(const float* samples, int numFrames, int numChannels,
+	                            FrameResult* outResults, int maxResults);
+
+	/**
+	 * Process planar multichannel audio at 44100 Hz (one pointer per channel)
+	 * Same downmix semantics as processAudioInterleaved
+	 */
+	int processAudioPlanar(const float* const* channels, int numFrames, int numChannels,
+	                       FrameResult* outResults, int maxResults);
+
 	/**
 	 * Process audio at 22050 Hz for BPM only (legacy compatibility)
 	 * Does NOT process key detection
@@ -144,6 +203,90 @@ public:
 	int processAudioForBpm(const float* samples, int numSamples,
 	                       FrameResult* outResults, int maxResults);
 
+	// =========================================================================
+	// Offline Analysis
+	// =========================================================================
+
+	/**
+	 * Final result of a whole-buffer analysis
+	 */
+	struct AnalysisResult {
+		float bpm;       // 0 if the buffer is too short (~2 seconds needed)
+		KeyResult key;   // invalid if too short (~20 seconds) or no key model
+	};
+
+	/**
+	 * Analyze a whole decoded buffer at 44100 Hz and return final BPM + key.
+	 *
+	 * Offline entry point for library scanning. The two pipeline branches are
+	 * fully independent, so they run concurrently: CQT extraction and key
+	 * inference on a second thread while the calling thread resamples,
+	 * extracts mel features and runs batched BeatNet inference. Skips the
+	 * streaming path's incremental bookkeeping (inference cadence, rolling
+	 * snapshots) - the key model sees the final window exactly once.
+	 *
+	 * Resets all streaming state on entry; call reset() before resuming
+	 * processAudio on the same instance.
+	 */
+	AnalysisResult analyzeBuffer(const float* samples, size_t numSamples);
+
+	// =========================================================================
+	// State Snapshot
+	// =========================================================================
+
+	/**
+	 * Serialize all streaming state to a compact binary blob
+	 *
+	 * Captures the LSTM tensors, activation and CQT rings with their
+	 * counters, resampler histories, mel buffers and the incremental key
+	 * pooling state, so a session can resume mid-track instead of
+	 * re-accumulating its ~20 second window. Call with audio stopped - the
+	 * snapshot is not synchronized against a concurrent processAudio.
+	 */
+	void serialize(std::vector<uint8_t>& out) const;
+
+	/**
+	 * Restore a snapshot written by serialize()
+	 *
+	 * The engine must be configured like the one that wrote the blob: same
+	 * build, input rate and CQT method, with models loaded if LSTM state is
+	 * to be reapplied. On any mismatch or truncation the engine is reset()
+	 * and false is returned, so state is never partially applied.
+	 */
+	bool restore(const uint8_t* data, size_t size);
+
+	// =========================================================================
+	// Telemetry
+	// =========================================================================
+
+	/**
+	 * Per-stage timing and counter snapshot
+	 *
+	 * Gathered with steady_clock timestamps around the existing stage calls;
+	 * the bookkeeping is a handful of relaxed atomic stores per chunk, cheap
+	 * enough to leave on in production. lastMicros is the most recent call's
+	 * duration, so a sampling profiler on top of getStats() can separate a
+	 * slow steady state from occasional spikes.
+	 */
+	struct Stats {
+		struct Stage {
+			uint64_t totalMicros;  // Cumulative since reset
+			uint64_t lastMicros;   // Most recent call
+			uint64_t calls;
+		};
+		Stage resample;       // Resampler::processStreaming
+		Stage mel;            // StreamingMelExtractor::push
+		Stage beatnet;        // OnnxModel::inferSequence
+		Stage cqt;            // StreamingCqtExtractor::push
+		Stage keyInference;   // KeyModel::inferVariable (worker thread)
+		uint64_t bpmFrames;   // Activation frames produced
+		uint64_t cqtFrames;   // CQT frames produced
+		uint64_t keyInferences;
+	};
+
+	/** Snapshot stage timings and counters (thread-safe, lock-free) */
+	Stats getStats() const;
+
 	// Constants
 	static constexpr int SAMPLE_RATE = 44100;           // Native sample rate
 	static constexpr int BPM_SAMPLE_RATE = MelConfig::SAMPLE_RATE;  // 22050 Hz
@@ -153,36 +296,142 @@ public:
 	static constexpr float BPM_FPS = 50.0f;
 	static constexpr float KEY_FPS = 5.0f;
 	static constexpr int KEY_MIN_FRAMES = 100;         // Minimum frames for first inference (~20 sec)
-	static constexpr int KEY_INFERENCE_INTERVAL = 25;  // Run inference every N new frames (~5 sec)
+	static constexpr int KEY_INFERENCE_INTERVAL = 25;  // Base inference cadence in frames (~5 sec)
+	static constexpr int KEY_MAX_INFERENCE_INTERVAL = 400;  // Backed-off cadence cap (~80 sec)
+	static constexpr float KEY_CONFIDENCE_THRESHOLD = 0.7f; // Needed to back off the cadence
 	static constexpr int KEY_MAX_FRAMES = 1200;        // Keep last 4 minutes at 5 FPS
 
 private:
 	static constexpr int MAX_CQT_FRAMES_PER_PUSH = 20;
 
-	// Run key inference on accumulated CQT frames
+	// Multichannel input is downmixed and processed in chunks of this many
+	// frames so the mono mix stays resident in cache between the downmix
+	// and the pipelines that consume it
+	static constexpr int DOWNMIX_CHUNK_FRAMES = 4096;
+
+	// Adaptive scheduling: a per-frame CQT energy swing beyond this fraction
+	// of the running average is treated as a track transition
+	static constexpr float KEY_ENERGY_SHIFT_RATIO = 0.5f;
+	static constexpr float KEY_ENERGY_EMA_ALPHA = 0.05f;
+
+	// Frames of already-processed context re-fed with each incremental
+	// inference chunk so the conv stack sees valid input at the seam
+	static constexpr int KEY_CHUNK_OVERLAP = 8;
+
+	// Snapshot the CQT window and hand it to the key inference worker
 	void runKeyInference();
 
+	// Worker-side: fold one chunk's logits into the pooled result unless
+	// the epoch changed (reset() ran) while the inference was in flight
+	void foldKeyResult(uint64_t epoch, int weight, const float* chunkLogits);
+
+	// Key inference worker thread (started when the key model loads)
+	void ensureKeyWorker();
+	void keyWorkerLoop();
+
 	// BPM detection
 	std::unique_ptr<StreamingMelExtractor> melExtractor_;
 	std::unique_ptr<OnnxModel> beatnetModel_;
 	std::unique_ptr<Resampler> resampler_;
 	ActivationBuffer activationBuffer_;
 
+	// Capture rate handling: when the host feeds a non-native rate (48000),
+	// keyResampler_ converts to 44100 for the key branch while resampler_
+	// takes the raw input straight to 22050 for the BPM branch
+	int inputRate_ = SAMPLE_RATE;
+	std::unique_ptr<Resampler> keyResampler_;
+	std::vector<float> keyResampleBuffer_;
+
+	// All fixed-size pipeline scratch is carved from this one allocation in
+	// the constructor, so the steady processing path never hits the heap
+	ScratchArena arena_;
+
 	// Key detection
 	std::unique_ptr<StreamingCqtExtractor> cqtExtractor_;
 	std::unique_ptr<KeyModel> keyModel_;
-	std::vector<float> cqtBuffer_;            // Ring buffer [KEY_MAX_FRAMES][N_BINS]
-	std::vector<float> cqtScratch_;           // Scratch for CQT extractor output
-	std::vector<float> cqtInferenceBuffer_;   // Contiguous window for inferVariable
+	float* cqtBuffer_ = nullptr;              // Freq-major ring [N_BINS][KEY_MAX_FRAMES]
+	float* cqtScratch_ = nullptr;             // Scratch for CQT extractor output
 	size_t cqtHead_ = 0;                      // Next write frame in cqtBuffer_
 	size_t cqtFrameCount_ = 0;                // Total frames processed since reset
 	size_t cqtWindowFrameCount_ = 0;          // Frames currently available in cqtBuffer_
-	size_t cqtFramesSinceInference_ = 0;      // Frames since last inference
+	size_t cqtFramesSinceInference_ = 0;      // Frames since last scheduled inference
+
+	// Adaptive inference cadence: doubles while consecutive results agree
+	// with high confidence, snaps back to the base interval on disagreement,
+	// low confidence, or a CQT energy shift (track transition)
+	size_t keyInterval_ = KEY_INFERENCE_INTERVAL;
+	bool keyJobEverPosted_ = false;           // First window job handed to the worker
+	int lastSeenKeyInference_ = 0;            // keyInferenceCount_ at last observation
+	std::string lastKeyCamelot_;              // Previous published key for agreement check
+	float cqtEnergyEma_ = 0.0f;               // Running mean of per-frame CQT energy
+
+	// Asynchronous key inference. processAudio linearizes the window into
+	// keySnapshot_ and notifies; the worker swaps the snapshot into its own
+	// buffer, runs the CNN off the audio path, and publishes into
+	// currentKey_ under keyResultMutex_. Posting a new snapshot while the
+	// worker is busy simply overwrites the pending one.
+	std::thread keyWorker_;
+	std::mutex keyMutex_;                     // Guards snapshot + scheduling state
+	std::condition_variable keyCv_;
+	mutable std::mutex keyResultMutex_;       // Guards currentKey_ and keyEpoch_
+	float* keySnapshot_ = nullptr;            // Pending chunk, [freq][time]
+	float* keyWorkBuffer_ = nullptr;          // Worker-side chunk (swapped in)
+	int keySnapshotFrames_ = 0;               // Frames in keySnapshot_
+	int keySnapshotWeight_ = 0;               // New (non-overlap) frames in the chunk
+	uint64_t keyEpoch_ = 0;                   // Bumped on reset() to drop stale results
+	bool keyJobPending_ = false;
+	bool keyWorkerBusy_ = false;              // Worker holds keyWorkBuffer_/model session
+	bool keyWorkerStop_ = false;
 	KeyResult currentKey_;                    // Latest key detection result
-	int keyInferenceCount_ = 0;               // Number of inferences performed
+	std::atomic<int> keyInferenceCount_{0};   // Number of inferences published
+
+	// Incremental pooling state (guarded by keyResultMutex_): the classifier
+	// head is linear over the pooled features, so a frame-weighted average of
+	// per-chunk logits stands in for pooling over the whole window. Weight is
+	// capped at KEY_MAX_FRAMES to keep a rolling 4-minute horizon.
+	float* keyLogitSum_ = nullptr;            // Weighted logit accumulator (24)
+	float keyLogitWeight_ = 0.0f;             // Total frames folded in
 
-	// Resampling buffer
+	// Mono mix scratch for the multichannel entry points, carved from the
+	// arena ([DOWNMIX_CHUNK_FRAMES])
+	float* downmixBuffer_ = nullptr;
+
+	// Resampling buffer. Kept as a vector: it can grow once for callers
+	// that push unusually large chunks, after which it never reallocates
 	std::vector<float> resampleBuffer_;
+
+	// Telemetry. Relaxed atomics: stages update from the audio and worker
+	// threads, getStats() reads from anywhere, and approximate consistency
+	// between fields is fine for monitoring
+	struct StageTimer {
+		std::atomic<uint64_t> totalMicros{0};
+		std::atomic<uint64_t> lastMicros{0};
+		std::atomic<uint64_t> calls{0};
+
+		void add(uint64_t micros) {
+			totalMicros.fetch_add(micros, std::memory_order_relaxed);
+			lastMicros.store(micros, std::memory_order_relaxed);
+			calls.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void clear() {
+			totalMicros.store(0, std::memory_order_relaxed);
+			lastMicros.store(0, std::memory_order_relaxed);
+			calls.store(0, std::memory_order_relaxed);
+		}
+
+		Stats::Stage snapshot() const {
+			return {totalMicros.load(std::memory_order_relaxed),
+			        lastMicros.load(std::memory_order_relaxed),
+			        calls.load(std::memory_order_relaxed)};
+		}
+	};
+	StageTimer resampleTimer_;
+	StageTimer melTimer_;
+	StageTimer beatnetTimer_;
+	StageTimer cqtTimer_;
+	StageTimer keyInferenceTimer_;
+	std::atomic<uint64_t> bpmFramesProduced_{0};
 };
 
 } // namespace engine
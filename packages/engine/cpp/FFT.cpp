@@ -5,66 +5,70 @@
 
 #include "FFT.hpp"
 #include "pocketfft_hdronly.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace engine {
 
-struct FFTImpl {
+struct FFT::Impl {
 	size_t size;
-	pocketfft::shape_t shape;
-	pocketfft::stride_t stride_in;
-	pocketfft::stride_t stride_out;
-	pocketfft::shape_t axes;
-
-	// Pre-allocated buffers
-	std::vector<float> inputBuffer;
-	std::vector<std::complex<float>> outputBuffer;
-};
 
-FFT::FFT(size_t size) : size_(size) {
-	auto* impl = new FFTImpl();
-	impl->size = size;
+	// Plan built once at construction; the functional pocketfft API would
+	// rebuild it (and allocate temporaries) on every transform
+	pocketfft::detail::pocketfft_r<float> plan;
 
-	// Setup for 1D real-to-complex FFT
-	impl->shape = {size};
-	impl->stride_in = {sizeof(float)};
-	impl->stride_out = {sizeof(std::complex<float>)};
-	impl->axes = {0};
+	// Pre-allocated in-place transform buffer
+	std::vector<float> buffer;
 
-	// Pre-allocate buffers
-	impl->inputBuffer.resize(size);
-	impl->outputBuffer.resize(size / 2 + 1);
+	explicit Impl(size_t n) : size(n), plan(n) {
+		buffer.resize(n);
+	}
+};
 
-	impl_ = impl;
-}
+FFT::FFT(size_t size) : size_(size), impl_(std::make_unique<Impl>(size)) {}
 
-FFT::~FFT() {
-	auto* impl = static_cast<FFTImpl*>(impl_);
-	delete impl;
-}
+FFT::~FFT() = default;
 
 void FFT::forward(const float* input, std::complex<float>* output) {
-	auto* impl = static_cast<FFTImpl*>(impl_);
-
-	// Copy input to buffer
-	std::copy(input, input + impl->size, impl->inputBuffer.begin());
-
-	// Perform real-to-complex FFT using pocketfft
-	// This matches numpy.fft.rfft exactly
-	pocketfft::r2c(
-		impl->shape,
-		impl->stride_in,
-		impl->stride_out,
-		impl->axes,
-		pocketfft::FORWARD,
-		impl->inputBuffer.data(),
-		impl->outputBuffer.data(),
-		1.0f  // No scaling (matches numpy)
-	);
-
-	// Copy to output
-	size_t outputSize = impl->size / 2 + 1;
-	std::copy(impl->outputBuffer.begin(), impl->outputBuffer.begin() + outputSize, output);
+	auto& impl = *impl_;
+
+	// Real-to-complex FFT with the cached plan, in-place in halfcomplex
+	// layout; no scaling (matches numpy.fft.rfft exactly)
+	std::copy(input, input + impl.size, impl.buffer.begin());
+	impl.plan.exec(impl.buffer.data(), 1.0f, true);
+
+	// Unpack halfcomplex (DC, then re/im pairs, Nyquist real for even
+	// sizes) into the complex bins numpy produces
+	const float* buf = impl.buffer.data();
+	output[0] = {buf[0], 0.0f};
+	size_t i = 1;
+	for (; 2 * i < impl.size; i++) {
+		output[i] = {buf[2 * i - 1], buf[2 * i]};
+	}
+	if (impl.size % 2 == 0) {
+		output[i] = {buf[impl.size - 1], 0.0f};
+	}
+}
+
+void FFT::inverse(const std::complex<float>* input, float* output) {
+	auto& impl = *impl_;
+
+	// Pack the complex spectrum back into halfcomplex layout, then run the
+	// backward transform with 1/size scaling (matches numpy.fft.irfft)
+	float* buf = impl.buffer.data();
+	buf[0] = input[0].real();
+	size_t i = 1;
+	for (; 2 * i < impl.size; i++) {
+		buf[2 * i - 1] = input[i].real();
+		buf[2 * i] = input[i].imag();
+	}
+	if (impl.size % 2 == 0) {
+		buf[impl.size - 1] = input[i].real();
+	}
+
+	impl.plan.exec(buf, 1.0f / static_cast<float>(impl.size), false);
+	std::copy(buf, buf + impl.size, output);
 }
 
 void FFT::magnitude(const std::complex<float>* fftOutput, float* magnitudes) {
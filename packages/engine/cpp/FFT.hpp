@@ -1,24 +1,26 @@
 #pragma once
 
 #include <cstddef>
-#include <vector>
+#include <memory>
 #include <complex>
 
 namespace engine {
 
 /**
- * FFT - Platform-abstracted Fast Fourier Transform
+ * FFT - Real-input Fast Fourier Transform
  *
- * iOS: Uses Apple Accelerate framework (vDSP)
- * Android: Uses KissFFT
- *
- * Computes real-to-complex FFT for audio processing.
+ * Backed by pocketfft (the numpy.fft backend): supports any transform
+ * size, builds its plan once at construction, and does no allocation per
+ * transform. Real-input r2c/c2r transforms do half the work of a complex
+ * transform on real data, and every consumer (MelExtractor's STFT, the
+ * autocorrelation BPM path) shares this one abstraction, so there is one
+ * place to optimize or swap the backend.
  */
 class FFT {
 public:
     /**
      * Create FFT processor for given size
-     * @param size FFT size (must be power of 2 for KissFFT, any for vDSP)
+     * @param size Transform size (any size; non-powers of two are fine)
      */
     explicit FFT(size_t size);
     ~FFT();
@@ -29,11 +31,20 @@ public:
 
     /**
      * Compute real-to-complex FFT
+     * Matches numpy.fft.rfft (no scaling)
      * @param input Real input samples (size elements)
      * @param output Complex output (size/2 + 1 elements)
      */
     void forward(const float* input, std::complex<float>* output);
 
+    /**
+     * Compute complex-to-real inverse FFT
+     * Matches numpy.fft.irfft (scaled by 1/size)
+     * @param input Complex spectrum (size/2 + 1 elements)
+     * @param output Real output samples (size elements)
+     */
+    void inverse(const std::complex<float>* input, float* output);
+
     /**
      * Get magnitude spectrum from complex FFT output
      * @param fftOutput Complex FFT output
@@ -54,8 +65,8 @@ public:
 private:
     size_t size_;
 
-    // Platform-specific implementation pointer
-    void* impl_;
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
 };
 
 } // namespace engine
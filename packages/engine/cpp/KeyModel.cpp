@@ -9,11 +9,9 @@
 #include "KeyModel.hpp"
 #include "OnnxRuntime.hpp"
 #include <onnxruntime_c_api.h>
-#ifdef ONNX_ENABLE_COREML
-#include <coreml_provider_factory.h>
-#endif
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 
 #ifdef __ANDROID__
@@ -118,6 +116,18 @@ void KeyModel::cleanup() {
 	auto& runtime = OnnxRuntime::instance();
 	const OrtApi* api = runtime.api();
 
+	if (api) {
+		if (inputTensor_) {
+			api->ReleaseValue(inputTensor_);
+			inputTensor_ = nullptr;
+		}
+		if (outputTensor_) {
+			api->ReleaseValue(outputTensor_);
+			outputTensor_ = nullptr;
+		}
+	}
+	boundFrames_ = 0;
+
 	if (session_ && api) {
 		api->ReleaseSession(session_);
 		session_ = nullptr;
@@ -129,9 +139,11 @@ void KeyModel::cleanup() {
 	isLoaded_ = false;
 }
 
-bool KeyModel::load(const std::string& modelPath) {
+bool KeyModel::load(const std::string& modelPath, ModelPrecision precision) {
 	cleanup();
 
+	const std::string resolved = resolveModelPath(modelPath, precision);
+
 	auto& runtime = OnnxRuntime::instance();
 	if (!runtime.isInitialized()) {
 		LOGE("ONNX Runtime not initialized\n");
@@ -150,32 +162,27 @@ bool KeyModel::load(const std::string& modelPath) {
 		return false;
 	}
 
-	(void)api_->SetSessionGraphOptimizationLevel(sessionOptions_, ORT_ENABLE_ALL);
-
-	// Enable CoreML on iOS/macOS for GPU acceleration
-	// NOTE: We use MLProgram format (0x010) and CPU+GPU (0x020) but NOT the
-	// COREML_FLAG_ONLY_ALLOW_STATIC_INPUT_SHAPES (0x008) flag, which means
-	// dynamic input shapes are allowed (needed for variable-length key detection)
-#ifdef ONNX_ENABLE_COREML
-	// COREML_FLAG_CREATE_MLPROGRAM (0x010) - Use ML Program format (iOS 15+, better compatibility)
-	// COREML_FLAG_USE_CPU_AND_GPU (0x020) - Use CPU and GPU compute units
-	// NOT setting COREML_FLAG_ONLY_ALLOW_STATIC_INPUT_SHAPES (0x008) allows dynamic shapes
-	uint32_t coreml_flags = COREML_FLAG_CREATE_MLPROGRAM | COREML_FLAG_USE_CPU_AND_GPU;
-	status = OrtSessionOptionsAppendExecutionProvider_CoreML(sessionOptions_, coreml_flags);
-	if (status != nullptr) {
-		// CoreML not available, fall back to CPU
-		LOGI("CoreML not available, using CPU\n");
-		api_->ReleaseStatus(status);
-		status = nullptr;
-	} else {
-		LOGI("CoreML enabled (MLProgram, CPU+GPU, dynamic shapes allowed)\n");
-	}
-#else
-	LOGI("Using CPU execution\n");
-#endif
+	// Shared provider/thread/optimization tuning (falls back to CPU when
+	// the configured provider is unavailable). The shared CoreML setup keeps
+	// dynamic input shapes allowed, which variable-length key input needs.
+	runtime.configureSessionOptions(sessionOptions_);
+
+	// Load the cached optimized graph when one exists, else arrange for it
+	// to be serialized while this session is created
+	std::string sessionPath;
+	const bool fromCache = runtime.applyModelCache(sessionOptions_, resolved, sessionPath);
 
 	// Create session from model file
-	status = api_->CreateSession(runtime.env(), modelPath.c_str(), sessionOptions_, &session_);
+	status = api_->CreateSession(runtime.env(), sessionPath.c_str(), sessionOptions_, &session_);
+	if (status != nullptr && fromCache) {
+		// Stale or corrupt cache entry - drop it and load the raw model
+		LOGE("Cached model rejected: %s. Reloading raw model\n",
+		     api_->GetErrorMessage(status));
+		api_->ReleaseStatus(status);
+		std::remove(sessionPath.c_str());
+		runtime.configureSessionOptions(sessionOptions_);
+		status = api_->CreateSession(runtime.env(), resolved.c_str(), sessionOptions_, &session_);
+	}
 	if (status != nullptr) {
 		const char* msg = api_->GetErrorMessage(status);
 		LOGE("CreateSession failed: %s\n", msg);
@@ -184,8 +191,18 @@ bool KeyModel::load(const std::string& modelPath) {
 		return false;
 	}
 
+	// Pre-bind the fixed-shape logits tensor over a member buffer; the
+	// input tensor is bound lazily since its time dimension varies
+	logits_.resize(NUM_CLASSES, 0.0f);
+	const int64_t outputShape[] = {1, NUM_CLASSES};
+	outputTensor_ = wrapTensor(logits_.data(), logits_.size(), outputShape, 2);
+	if (outputTensor_ == nullptr) {
+		cleanup();
+		return false;
+	}
+
 	isLoaded_ = true;
-	LOGI("MusicalKeyCNN model loaded: %s\n", modelPath.c_str());
+	LOGI("MusicalKeyCNN model loaded: %s\n", resolved.c_str());
 	return true;
 }
 
@@ -213,43 +230,80 @@ void KeyModel::softmax(float* logits, int size) {
 	}
 }
 
-bool KeyModel::infer(const float* cqtSpectrogram, KeyOutput& output, float* probabilities) {
-	if (!isReady()) {
-		LOGE("Model not ready\n");
-		return false;
-	}
-
-	auto& runtime = OnnxRuntime::instance();
-	OrtStatus* status = nullptr;
-
-	// Input shape: [batch=1, channel=1, freq=105, time=100]
-	const int64_t inputShape[] = {1, 1, INPUT_FREQ_BINS, INPUT_TIME_FRAMES};
-	const size_t inputSize = INPUT_SIZE * sizeof(float);
-
-	// Create input tensor
-	OrtValue* inputTensor = nullptr;
-	status = api_->CreateTensorWithDataAsOrtValue(
-		runtime.memoryInfo(),
-		const_cast<float*>(cqtSpectrogram),
-		inputSize,
-		inputShape,
-		4,
+OrtValue* KeyModel::wrapTensor(float* data, size_t count,
+                               const int64_t* shape, size_t numDims) {
+	OrtValue* value = nullptr;
+	OrtStatus* status = api_->CreateTensorWithDataAsOrtValue(
+		OnnxRuntime::instance().memoryInfo(),
+		data,
+		count * sizeof(float),
+		shape,
+		numDims,
 		ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
-		&inputTensor
+		&value
 	);
-
 	if (status != nullptr) {
 		const char* msg = api_->GetErrorMessage(status);
 		LOGE("CreateTensorWithDataAsOrtValue failed: %s\n", msg);
 		api_->ReleaseStatus(status);
+		return nullptr;
+	}
+	return value;
+}
+
+bool KeyModel::bindFrames(int numFrames) {
+	if (numFrames == boundFrames_) {
+		return true;
+	}
+
+	// Time dimension changed: rebind the input tensor over the resized
+	// staging buffer. Once the Engine's rolling window fills, the length is
+	// constant and this never runs again.
+	if (inputTensor_) {
+		api_->ReleaseValue(inputTensor_);
+		inputTensor_ = nullptr;
+	}
+	boundFrames_ = 0;
+
+	inputData_.resize(static_cast<size_t>(INPUT_FREQ_BINS) * numFrames);
+
+	// Input shape: [batch=1, channel=1, freq=105, time=numFrames]
+	const int64_t inputShape[] = {1, 1, INPUT_FREQ_BINS, static_cast<int64_t>(numFrames)};
+	inputTensor_ = wrapTensor(inputData_.data(), inputData_.size(), inputShape, 4);
+	if (inputTensor_ == nullptr) {
 		return false;
 	}
 
-	// Run inference
-	OrtValue* outputs[1] = {nullptr};
-	const OrtValue* inputs[1] = {inputTensor};
+	boundFrames_ = numFrames;
+	return true;
+}
+
+void KeyModel::classify(const float* logits, KeyOutput& output) {
+	float probs[NUM_CLASSES];
+	std::memcpy(probs, logits, NUM_CLASSES * sizeof(float));
+	softmax(probs, NUM_CLASSES);
+
+	// Find predicted class (argmax)
+	int predictedClass = 0;
+	float maxProb = probs[0];
+	for (int i = 1; i < NUM_CLASSES; i++) {
+		if (probs[i] > maxProb) {
+			maxProb = probs[i];
+			predictedClass = i;
+		}
+	}
+
+	output.keyIndex = predictedClass;
+	output.confidence = maxProb;
+	output.camelot = CAMELOT_KEYS[predictedClass];
+	output.notation = NOTATION_KEYS[predictedClass];
+}
+
+bool KeyModel::runBound(KeyOutput& output, float* probabilities, float* logits) {
+	const OrtValue* inputs[1] = {inputTensor_};
+	OrtValue* outputs[1] = {outputTensor_};
 
-	status = api_->Run(
+	OrtStatus* status = api_->Run(
 		session_,
 		nullptr,  // Run options
 		inputNames_.data(),
@@ -260,9 +314,6 @@ bool KeyModel::infer(const float* cqtSpectrogram, KeyOutput& output, float* prob
 		outputs
 	);
 
-	// Release input tensor
-	api_->ReleaseValue(inputTensor);
-
 	if (status != nullptr) {
 		const char* msg = api_->GetErrorMessage(status);
 		LOGE("Run failed: %s\n", msg);
@@ -270,154 +321,61 @@ bool KeyModel::infer(const float* cqtSpectrogram, KeyOutput& output, float* prob
 		return false;
 	}
 
-	// Get output data
-	float* outputData = nullptr;
-	status = api_->GetTensorMutableData(outputs[0], (void**)&outputData);
-	if (status != nullptr) {
-		const char* msg = api_->GetErrorMessage(status);
-		LOGE("GetTensorMutableData failed: %s\n", msg);
-		api_->ReleaseStatus(status);
-		api_->ReleaseValue(outputs[0]);
-		return false;
+	// Run wrote the raw logits into the bound buffer
+	if (logits != nullptr) {
+		std::memcpy(logits, logits_.data(), NUM_CLASSES * sizeof(float));
 	}
 
-	// Copy output logits
-	float logits[NUM_CLASSES];
-	std::memcpy(logits, outputData, NUM_CLASSES * sizeof(float));
-
-	// Release output tensor
-	api_->ReleaseValue(outputs[0]);
-
-	// Apply softmax to get probabilities
-	softmax(logits, NUM_CLASSES);
-
-	// Find predicted class (argmax)
-	int predictedClass = 0;
-	float maxProb = logits[0];
-	for (int i = 1; i < NUM_CLASSES; i++) {
-		if (logits[i] > maxProb) {
-			maxProb = logits[i];
-			predictedClass = i;
-		}
-	}
-
-	// Fill output
-	output.keyIndex = predictedClass;
-	output.confidence = maxProb;
-	output.camelot = CAMELOT_KEYS[predictedClass];
-	output.notation = NOTATION_KEYS[predictedClass];
+	classify(logits_.data(), output);
 
 	// Copy all probabilities if requested (for voting/averaging)
 	if (probabilities != nullptr) {
-		std::memcpy(probabilities, logits, NUM_CLASSES * sizeof(float));
+		float probs[NUM_CLASSES];
+		std::memcpy(probs, logits_.data(), NUM_CLASSES * sizeof(float));
+		softmax(probs, NUM_CLASSES);
+		std::memcpy(probabilities, probs, NUM_CLASSES * sizeof(float));
 	}
 
 	return true;
 }
 
-bool KeyModel::inferVariable(const float* cqtSpectrogram, int numFrames, KeyOutput& output) {
+bool KeyModel::infer(const float* cqtSpectrogram, KeyOutput& output, float* probabilities) {
 	if (!isReady()) {
 		LOGE("Model not ready\n");
 		return false;
 	}
 
-	if (numFrames < 1) {
-		LOGE("Need at least 1 frame\n");
+	if (!bindFrames(INPUT_TIME_FRAMES)) {
 		return false;
 	}
 
-	auto& runtime = OnnxRuntime::instance();
-	OrtStatus* status = nullptr;
-
-	// Input arrives in row-major [time][freq] from Engine.
-	// Transpose to [freq][time] for ONNX input tensor shape [1, 1, freq, time].
-	std::vector<float> transposed(INPUT_FREQ_BINS * numFrames);
-	for (int t = 0; t < numFrames; t++) {
-		for (int f = 0; f < INPUT_FREQ_BINS; f++) {
-			transposed[f * numFrames + t] = cqtSpectrogram[t * INPUT_FREQ_BINS + f];
-		}
-	}
+	// Caller already provides [freq][time]; stage into the bound buffer
+	std::memcpy(inputData_.data(), cqtSpectrogram, INPUT_SIZE * sizeof(float));
 
-	// Input shape: [batch=1, channel=1, freq=105, time=numFrames]
-	const int64_t inputShape[] = {1, 1, INPUT_FREQ_BINS, static_cast<int64_t>(numFrames)};
-	const size_t inputSize = INPUT_FREQ_BINS * numFrames * sizeof(float);
-
-	OrtValue* inputTensor = nullptr;
-	status = api_->CreateTensorWithDataAsOrtValue(
-		runtime.memoryInfo(),
-		transposed.data(),
-		inputSize,
-		inputShape,
-		4,
-		ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
-		&inputTensor
-	);
+	return runBound(output, probabilities, nullptr);
+}
 
-	if (status != nullptr) {
-		const char* msg = api_->GetErrorMessage(status);
-		LOGE("CreateTensorWithDataAsOrtValue failed: %s\n", msg);
-		api_->ReleaseStatus(status);
+bool KeyModel::inferVariable(const float* cqtSpectrogram, int numFrames, KeyOutput& output,
+                             float* logits) {
+	if (!isReady()) {
+		LOGE("Model not ready\n");
 		return false;
 	}
 
-	// Run inference
-	OrtValue* outputs[1] = {nullptr};
-	const OrtValue* inputs[1] = {inputTensor};
-
-	status = api_->Run(
-		session_,
-		nullptr,
-		inputNames_.data(),
-		inputs,
-		1,
-		outputNames_.data(),
-		1,
-		outputs
-	);
-
-	api_->ReleaseValue(inputTensor);
-
-	if (status != nullptr) {
-		const char* msg = api_->GetErrorMessage(status);
-		LOGE("Run failed: %s\n", msg);
-		api_->ReleaseStatus(status);
+	if (numFrames < 1) {
+		LOGE("Need at least 1 frame\n");
 		return false;
 	}
 
-	// Get output data
-	float* outputData = nullptr;
-	status = api_->GetTensorMutableData(outputs[0], (void**)&outputData);
-	if (status != nullptr) {
-		const char* msg = api_->GetErrorMessage(status);
-		LOGE("GetTensorMutableData failed: %s\n", msg);
-		api_->ReleaseStatus(status);
-		api_->ReleaseValue(outputs[0]);
+	if (!bindFrames(numFrames)) {
 		return false;
 	}
 
-	// Copy and process output
-	float logits[NUM_CLASSES];
-	std::memcpy(logits, outputData, NUM_CLASSES * sizeof(float));
-	api_->ReleaseValue(outputs[0]);
+	// Input arrives model-ready ([freq][time]); stage into the bound buffer
+	std::memcpy(inputData_.data(), cqtSpectrogram,
+	            static_cast<size_t>(INPUT_FREQ_BINS) * numFrames * sizeof(float));
 
-	softmax(logits, NUM_CLASSES);
-
-	// Find predicted class
-	int predictedClass = 0;
-	float maxProb = logits[0];
-	for (int i = 1; i < NUM_CLASSES; i++) {
-		if (logits[i] > maxProb) {
-			maxProb = logits[i];
-			predictedClass = i;
-		}
-	}
-
-	output.keyIndex = predictedClass;
-	output.confidence = maxProb;
-	output.camelot = CAMELOT_KEYS[predictedClass];
-	output.notation = NOTATION_KEYS[predictedClass];
-
-	return true;
+	return runBound(output, nullptr, logits);
 }
 
 } // namespace engine
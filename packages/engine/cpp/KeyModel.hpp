@@ -1,9 +1,12 @@
 #pragma once
 
+#include "ModelPrecision.hpp"
+
 #include <string>
 
 #ifdef ONNX_ENABLED
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -11,6 +14,7 @@
 struct OrtApi;
 struct OrtSession;
 struct OrtSessionOptions;
+struct OrtValue;
 
 namespace engine {
 
@@ -45,10 +49,13 @@ public:
 
 	/**
 	 * Load model from file path
-	 * @param modelPath Path to .onnx model file
+	 * @param modelPath Path to the float32 .onnx model file
+	 * @param precision Requested precision; resolves to a quantized sibling
+	 *                  (keynet.int8.onnx) when one is shipped, else float32
 	 * @return true if loaded successfully
 	 */
-	bool load(const std::string& modelPath);
+	bool load(const std::string& modelPath,
+	          ModelPrecision precision = ModelPrecision::Auto);
 
 	/**
 	 * Check if model is loaded and ready
@@ -69,14 +76,23 @@ public:
 	 * Model uses AdaptiveAvgPool2d so accepts any number of time frames >= 1
 	 * More frames = more context = higher accuracy
 	 *
-	 * @param cqtSpectrogram CQT features, row-major [time][freq] (numFrames x 105)
-	 *                      Engine stores frames in time-major order; this method
-	 *                      transposes internally to [freq][time] for model input.
+	 * @param cqtSpectrogram CQT features, row-major [freq][time] (105 x numFrames),
+	 *                      i.e. model-ready layout. Engine keeps its ring
+	 *                      freq-major so no transpose happens on this path.
 	 * @param numFrames Number of time frames (should be >= 100 for good accuracy)
 	 * @param output Output key detection result
+	 * @param logits Optional output buffer for raw pre-softmax logits
+	 *               (24 floats, for incremental averaging across chunks)
 	 * @return true if inference succeeded
 	 */
-	bool inferVariable(const float* cqtSpectrogram, int numFrames, KeyOutput& output);
+	bool inferVariable(const float* cqtSpectrogram, int numFrames, KeyOutput& output,
+	                   float* logits = nullptr);
+
+	/**
+	 * Classify a 24-logit vector (softmax + argmax + key mapping).
+	 * Used by callers that average logits across multiple inference chunks.
+	 */
+	static void classify(const float* logits, KeyOutput& output);
 
 	// Constants matching the model architecture
 	static constexpr int INPUT_FREQ_BINS = 105;
@@ -91,6 +107,9 @@ public:
 private:
 	void cleanup();
 	static void softmax(float* logits, int size);
+	OrtValue* wrapTensor(float* data, size_t count, const std::int64_t* shape, size_t numDims);
+	bool bindFrames(int numFrames);
+	bool runBound(KeyOutput& output, float* probabilities, float* logits);
 
 	const OrtApi* api_ = nullptr;
 	OrtSession* session_ = nullptr;
@@ -99,6 +118,15 @@ private:
 	std::vector<const char*> inputNames_;
 	std::vector<const char*> outputNames_;
 
+	// Persistent pre-bound tensors wrapping the buffers below. The logits
+	// tensor is created once in load(); the input tensor is rebound only
+	// when the time dimension changes.
+	OrtValue* inputTensor_ = nullptr;
+	OrtValue* outputTensor_ = nullptr;
+	int boundFrames_ = 0;
+	std::vector<float> inputData_;    // [freq][time] staging buffer
+	std::vector<float> logits_;
+
 	bool isLoaded_ = false;
 };
 
@@ -121,10 +149,11 @@ public:
 	KeyModel() = default;
 	~KeyModel() = default;
 
-	bool load(const std::string&) { return false; }
+	bool load(const std::string&, ModelPrecision = ModelPrecision::Auto) { return false; }
 	bool isReady() const { return false; }
 	bool infer(const float*, KeyOutput&, float* = nullptr) { return false; }
-	bool inferVariable(const float*, int, KeyOutput&) { return false; }
+	bool inferVariable(const float*, int, KeyOutput&, float* = nullptr) { return false; }
+	static void classify(const float*, KeyOutput&) {}
 
 	static constexpr int INPUT_FREQ_BINS = 105;
 	static constexpr int INPUT_TIME_FRAMES = 100;
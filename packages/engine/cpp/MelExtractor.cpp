@@ -7,6 +7,7 @@
 
 #include "MelExtractor.hpp"
 #include "FFT.hpp"
+#include "VecMath.hpp"
 #include <cstring>
 #include <algorithm>
 #include <cmath>
@@ -184,17 +185,39 @@ LogFilterbank::LogFilterbank(int fftSize, int sampleRate, int bandsPerOctave,
             }
         }
 
-        filters_.push_back(std::move(filter));
+        // Compress to CSR: store only the filter's nonzero span so apply()
+        // walks a contiguous weight array instead of 705 mostly-zero bins
+        int first = 0;
+        while (first < numBins_ && filter[first] == 0.0f) {
+            first++;
+        }
+        int last = numBins_ - 1;
+        while (last >= first && filter[last] == 0.0f) {
+            last--;
+        }
+
+        starts_.push_back(first <= last ? first : 0);
+        offsets_.push_back(static_cast<int>(weights_.size()));
+        lengths_.push_back(first <= last ? last - first + 1 : 0);
+        for (int k = first; k <= last; k++) {
+            weights_.push_back(filter[k]);
+        }
+
         numBands_++;
     }
 }
 
 void LogFilterbank::apply(const float* magnitude, float* output) const {
+    // Narrow contiguous dot product per band; the flat layout keeps the
+    // weights cache-resident and lets the compiler vectorize the inner loop
     for (int m = 0; m < numBands_; m++) {
+        const float* w = weights_.data() + offsets_[m];
+        const float* x = magnitude + starts_[m];
+        const int len = lengths_[m];
+
         float sum = 0.0f;
-        const auto& filter = filters_[m];
-        for (int k = 0; k < numBins_; k++) {
-            sum += magnitude[k] * filter[k];
+        for (int k = 0; k < len; k++) {
+            sum += x[k] * w[k];
         }
         output[m] = sum;
     }
@@ -266,6 +289,25 @@ void MelExtractor::reset() {
     std::fill(impl_->previousLogMel.begin(), impl_->previousLogMel.end(), 0.0f);
 }
 
+void MelExtractor::saveState(StateWriter& w) const {
+    auto& impl = *impl_;
+    w.write(static_cast<uint8_t>(impl.hasPreviousFrame ? 1 : 0));
+    w.write(static_cast<uint32_t>(impl.previousLogMel.size()));
+    w.writeFloats(impl.previousLogMel.data(), impl.previousLogMel.size());
+}
+
+bool MelExtractor::loadState(StateReader& r) {
+    auto& impl = *impl_;
+    uint8_t hasPrevious = 0;
+    if (!r.read(hasPrevious) ||
+        !r.expect(static_cast<uint32_t>(impl.previousLogMel.size())) ||
+        !r.readFloats(impl.previousLogMel.data(), impl.previousLogMel.size())) {
+        return false;
+    }
+    impl.hasPreviousFrame = hasPrevious != 0;
+    return true;
+}
+
 bool MelExtractor::processFrame(const float* frame, int frameLength, float* features) {
     auto& impl = *impl_;
     const int winLength = MelConfig::WIN_LENGTH;
@@ -294,9 +336,7 @@ bool MelExtractor::processFrame(const float* frame, int frameLength, float* feat
     impl.filterbank->apply(impl.magnitudeBuffer.data(), impl.filteredBuffer.data());
 
     // Apply log scaling: log10(1 + S) - matches LogarithmicSpectrogramProcessor(mul=1, add=1)
-    for (int i = 0; i < nBands; i++) {
-        impl.logMelBuffer[i] = std::log10(1.0f + impl.filteredBuffer[i]);
-    }
+    vecmath::log10p1(impl.filteredBuffer.data(), impl.logMelBuffer.data(), nBands);
 
     // Compute spectral difference
     // First frame: diff is all zeros (no previous frame to compare against)
@@ -334,12 +374,16 @@ struct StreamingMelExtractor::Impl {
     int writePos;
     int samplesUntilNextFrame;
 
+    // Persistent frame assembly buffer - push() must not allocate
+    std::vector<float> frame;
+
     // Pre-padding for centered frames (madmom compatibility)
     static constexpr int PADDING = MelConfig::WIN_LENGTH / 2;  // 705
 
     Impl() {
         // Buffer size: enough for one full window plus one hop
         buffer.resize(MelConfig::WIN_LENGTH + MelConfig::HOP_LENGTH, 0.0f);
+        frame.resize(MelConfig::WIN_LENGTH, 0.0f);
 
         // Pre-fill with zeros for centered framing (like madmom)
         // Frame 0 is centered at sample 0, so it uses zeros[0:705] + audio[0:706]
@@ -364,6 +408,32 @@ void StreamingMelExtractor::reset() {
     impl_->samplesUntilNextFrame = MelConfig::WIN_LENGTH - Impl::PADDING;
 }
 
+void StreamingMelExtractor::saveState(StateWriter& w) const {
+    auto& impl = *impl_;
+    impl.extractor.saveState(w);
+    w.write(static_cast<uint32_t>(impl.buffer.size()));
+    w.writeFloats(impl.buffer.data(), impl.buffer.size());
+    w.write(static_cast<int32_t>(impl.writePos));
+    w.write(static_cast<int32_t>(impl.samplesUntilNextFrame));
+}
+
+bool StreamingMelExtractor::loadState(StateReader& r) {
+    auto& impl = *impl_;
+    if (!impl.extractor.loadState(r) ||
+        !r.expect(static_cast<uint32_t>(impl.buffer.size())) ||
+        !r.readFloats(impl.buffer.data(), impl.buffer.size())) {
+        return false;
+    }
+    int32_t writePos = 0;
+    int32_t untilNext = 0;
+    if (!r.read(writePos) || !r.read(untilNext)) {
+        return false;
+    }
+    impl.writePos = writePos;
+    impl.samplesUntilNextFrame = untilNext;
+    return true;
+}
+
 int StreamingMelExtractor::push(const float* samples, int numSamples,
                                  float* features, int maxFrames) {
     auto& impl = *impl_;
@@ -373,39 +443,58 @@ int StreamingMelExtractor::push(const float* samples, int numSamples,
     const int featureDim = MelConfig::MODEL_INPUT_DIM;
 
     int framesProduced = 0;
-    std::vector<float> frame(winLength);
     float spill[MelConfig::MODEL_INPUT_DIM] = {0};
 
-    for (int i = 0; i < numSamples; i++) {
-        // Write sample to circular buffer
-        impl.buffer[impl.writePos % bufferSize] = samples[i];
-        impl.writePos++;
-        impl.samplesUntilNextFrame--;
-
-        // Check if we have a complete frame
-        if (impl.samplesUntilNextFrame <= 0) {
-            // Extract frame from circular buffer
-            const int startPos = impl.writePos - winLength;
-            for (int j = 0; j < winLength; j++) {
-                int bufIdx = ((startPos + j) % bufferSize + bufferSize) % bufferSize;
-                frame[j] = impl.buffer[bufIdx];
-            }
+    // Block-based hop extraction: input is copied into the ring in wrap-safe
+    // memcpy runs up to the next frame boundary, and each due window is
+    // handed to the extractor either in place (no wrap) or via a two-memcpy
+    // reassembly. For large offline pushes this turns per-sample ring
+    // bookkeeping into a handful of bulk copies per 441-sample hop, leaving
+    // the FFT and filterbank as the only per-frame work.
+    int consumed = 0;
+    while (consumed < numSamples) {
+        const int run = std::min(numSamples - consumed, impl.samplesUntilNextFrame);
+        const int pos = impl.writePos % bufferSize;
+        const int head = std::min(run, bufferSize - pos);
+        std::memcpy(&impl.buffer[pos], samples + consumed, head * sizeof(float));
+        if (run > head) {
+            std::memcpy(impl.buffer.data(), samples + consumed + head,
+                        (run - head) * sizeof(float));
+        }
+        impl.writePos += run;
+        impl.samplesUntilNextFrame -= run;
+        consumed += run;
 
-            float* out = spill;
-            if (framesProduced < maxFrames) {
-                out = features + framesProduced * featureDim;
-            }
+        if (impl.samplesUntilNextFrame > 0) {
+            continue;
+        }
+
+        // Window of the frame ending at writePos; use the ring's storage
+        // directly when the window happens to be contiguous
+        const int start = (impl.writePos - winLength) % bufferSize;
+        const float* window = &impl.buffer[start];
+        const int tail = bufferSize - start;
+        if (tail < winLength) {
+            std::memcpy(impl.frame.data(), &impl.buffer[start], tail * sizeof(float));
+            std::memcpy(impl.frame.data() + tail, impl.buffer.data(),
+                        (winLength - tail) * sizeof(float));
+            window = impl.frame.data();
+        }
 
-            // Process frame to keep extractor state in sync with consumed samples.
-            bool hasFeatures = impl.extractor.processFrame(frame.data(), winLength, out);
+        float* out = spill;
+        if (framesProduced < maxFrames) {
+            out = features + framesProduced * featureDim;
+        }
 
-            if (hasFeatures && framesProduced < maxFrames) {
-                framesProduced++;
-            }
+        // Process frame to keep extractor state in sync with consumed samples.
+        bool hasFeatures = impl.extractor.processFrame(window, winLength, out);
 
-            // Next frame after hopLength samples
-            impl.samplesUntilNextFrame = hopLength;
+        if (hasFeatures && framesProduced < maxFrames) {
+            framesProduced++;
         }
+
+        // Next frame after hopLength samples
+        impl.samplesUntilNextFrame = hopLength;
     }
 
     return framesProduced;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "StateBlob.hpp"
 #include <cstddef>
 #include <vector>
 #include <cmath>
@@ -43,7 +44,15 @@ public:
 private:
     int numBands_;
     int numBins_;
-    std::vector<std::vector<float>> filters_;
+
+    // CSR-style flattened filterbank. Each triangular filter touches only a
+    // narrow contiguous bin range, so band m is stored as its nonzero span:
+    // weights at weights_[offsets_[m]..] applied to magnitude bins
+    // [starts_[m], starts_[m] + lengths_[m]).
+    std::vector<float> weights_;
+    std::vector<int> starts_;
+    std::vector<int> offsets_;
+    std::vector<int> lengths_;
 };
 
 /**
@@ -82,6 +91,12 @@ public:
         return static_cast<float>(MelConfig::SAMPLE_RATE) / MelConfig::HOP_LENGTH;
     }
 
+    /** Serialize the spectral-diff state for Engine snapshots */
+    void saveState(StateWriter& w) const;
+
+    /** Restore a snapshot written by saveState */
+    bool loadState(StateReader& r);
+
 private:
     // Forward declaration of implementation
     struct Impl;
@@ -119,6 +134,12 @@ public:
     /** Get frames per second (50) */
     static constexpr float getFps() { return MelExtractor::getFps(); }
 
+    /** Serialize the sample buffer and frame schedule for Engine snapshots */
+    void saveState(StateWriter& w) const;
+
+    /** Restore a snapshot written by saveState */
+    bool loadState(StateReader& r);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
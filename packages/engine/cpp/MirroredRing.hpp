@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+
+/**
+ * Fixed-capacity float ring storage with double-mapped virtual memory.
+ *
+ * The backing pages are mapped twice back-to-back, so a window of up to
+ * capacity() elements starting at any logical position reads through a
+ * plain contiguous pointer — no copy-out to fake contiguity across the
+ * wrap. On Linux/Android this uses memfd_create plus two fixed mappings
+ * of the same pages; where the platform forbids it (or the mapping fails)
+ * it falls back to a plain allocation of twice the capacity where store()
+ * writes each element into both images, trading one extra write per
+ * sample for the same contiguous-read guarantee.
+ *
+ * Capacity is rounded up to a whole number of pages so the two mappings
+ * can abut exactly; callers must take their ring modulo from capacity().
+ */
+class MirroredRing {
+public:
+	explicit MirroredRing(size_t minCapacity) {
+		size_t pageSize = 4096;
+#if defined(__linux__)
+		long sysPage = sysconf(_SC_PAGESIZE);
+		if (sysPage > 0) {
+			pageSize = static_cast<size_t>(sysPage);
+		}
+#endif
+		size_t bytes = minCapacity * sizeof(float);
+		bytes = ((bytes + pageSize - 1) / pageSize) * pageSize;
+		capacity_ = bytes / sizeof(float);
+		bytes_ = bytes;
+
+#if defined(__linux__)
+		int fd = memfd_create("engine-mirrored-ring", MFD_CLOEXEC);
+		if (fd >= 0) {
+			if (ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+				// Reserve both halves, then map the same pages into each
+				void* base = mmap(nullptr, 2 * bytes, PROT_NONE,
+				                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (base != MAP_FAILED) {
+					void* lo = mmap(base, bytes, PROT_READ | PROT_WRITE,
+					                MAP_SHARED | MAP_FIXED, fd, 0);
+					void* hi = mmap(static_cast<char*>(base) + bytes, bytes,
+					                PROT_READ | PROT_WRITE,
+					                MAP_SHARED | MAP_FIXED, fd, 0);
+					if (lo != MAP_FAILED && hi != MAP_FAILED) {
+						data_ = static_cast<float*>(base);
+						mapped_ = true;
+					} else {
+						munmap(base, 2 * bytes);
+					}
+				}
+			}
+			close(fd);
+		}
+#endif
+
+		if (!mapped_) {
+			fallback_.assign(2 * capacity_, 0.0f);
+			data_ = fallback_.data();
+		}
+	}
+
+	~MirroredRing() {
+#if defined(__linux__)
+		if (mapped_) {
+			munmap(data_, 2 * bytes_);
+		}
+#endif
+	}
+
+	// Non-copyable (owns a mapping)
+	MirroredRing(const MirroredRing&) = delete;
+	MirroredRing& operator=(const MirroredRing&) = delete;
+
+	/**
+	 * Usable ring capacity in elements (>= the requested minimum).
+	 * Ring positions must be taken modulo this value.
+	 */
+	size_t capacity() const {
+		return capacity_;
+	}
+
+	/**
+	 * True when the double mapping is active (reads and writes are
+	 * mirrored by the MMU rather than by duplicate stores).
+	 */
+	bool isMapped() const {
+		return mapped_;
+	}
+
+	/**
+	 * Write n elements at logical position pos (pos < capacity, n <= capacity).
+	 * Writes that run past the logical end land in the mirror and therefore
+	 * wrap automatically.
+	 */
+	void store(size_t pos, const float* src, size_t n) {
+		if (mapped_) {
+			std::memcpy(data_ + pos, src, n * sizeof(float));
+			return;
+		}
+		// Fallback: keep both images in sync with explicit wrap handling
+		size_t first = n < capacity_ - pos ? n : capacity_ - pos;
+		std::memcpy(data_ + pos, src, first * sizeof(float));
+		std::memcpy(data_ + capacity_ + pos, src, first * sizeof(float));
+		if (first < n) {
+			std::memcpy(data_, src + first, (n - first) * sizeof(float));
+			std::memcpy(data_ + capacity_, src + first, (n - first) * sizeof(float));
+		}
+	}
+
+	/**
+	 * Contiguous read pointer for a window starting at logical position pos
+	 * (pos < capacity). Valid for up to capacity() elements.
+	 */
+	const float* window(size_t pos) const {
+		return data_ + pos;
+	}
+
+	void fill(float value) {
+		size_t total = mapped_ ? capacity_ : 2 * capacity_;
+		for (size_t i = 0; i < total; i++) {
+			data_[i] = value;
+		}
+	}
+
+private:
+	float* data_ = nullptr;
+	size_t capacity_ = 0;
+	size_t bytes_ = 0;
+	bool mapped_ = false;
+	std::vector<float> fallback_;
+};
+
+} // namespace engine
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+namespace engine {
+
+/**
+ * Requested numeric precision for an ONNX model file
+ *
+ * Quantized variants live next to the float32 model with a suffix before the
+ * extension (beatnet.int8.onnx, keynet.fp16.onnx). They are produced by the
+ * model export pipeline; resolution falls back to the float32 file whenever
+ * the requested variant is not shipped, so callers can always ask for the
+ * cheapest precision without checking what was bundled.
+ */
+enum class ModelPrecision {
+	Auto,     // Prefer quantized variants on ARM, float32 elsewhere
+	Float32,  // Load the given path as-is
+	Float16,  // Prefer <name>.fp16.onnx
+	Int8,     // Prefer <name>.int8.onnx
+};
+
+namespace detail {
+
+inline bool modelFileExists(const std::string& path) {
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file) {
+		return false;
+	}
+	fclose(file);
+	return true;
+}
+
+/** Insert a variant suffix before the file extension */
+inline std::string modelVariantPath(const std::string& path, const char* suffix) {
+	const size_t dot = path.rfind('.');
+	if (dot == std::string::npos) {
+		return path + suffix;
+	}
+	return path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+} // namespace detail
+
+/**
+ * Resolve a float32 model path to the variant matching the requested precision
+ * @param path Path to the float32 .onnx file
+ * @return Path to the variant to load (the input path if no variant exists)
+ */
+inline std::string resolveModelPath(const std::string& path, ModelPrecision precision) {
+	switch (precision) {
+	case ModelPrecision::Int8: {
+		const std::string int8 = detail::modelVariantPath(path, ".int8");
+		return detail::modelFileExists(int8) ? int8 : path;
+	}
+	case ModelPrecision::Float16: {
+		const std::string fp16 = detail::modelVariantPath(path, ".fp16");
+		return detail::modelFileExists(fp16) ? fp16 : path;
+	}
+	case ModelPrecision::Auto: {
+		// Quantization pays off on ARM (2-4x inference, NNAPI/NEON int8
+		// paths); on desktop the float32 model is fastest and exact.
+#if defined(__aarch64__) || defined(__arm__)
+		const std::string int8 = detail::modelVariantPath(path, ".int8");
+		if (detail::modelFileExists(int8)) {
+			return int8;
+		}
+		const std::string fp16 = detail::modelVariantPath(path, ".fp16");
+		if (detail::modelFileExists(fp16)) {
+			return fp16;
+		}
+#endif
+		return path;
+	}
+	case ModelPrecision::Float32:
+	default:
+		return path;
+	}
+}
+
+} // namespace engine
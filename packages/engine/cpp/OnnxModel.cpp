@@ -7,10 +7,9 @@
 #include "OnnxModel.hpp"
 #include "OnnxRuntime.hpp"
 #include <onnxruntime_c_api.h>
-#ifdef ONNX_ENABLE_COREML
-#include <coreml_provider_factory.h>
-#endif
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 
 #ifdef __ANDROID__
@@ -41,6 +40,18 @@ OnnxModel::~OnnxModel() {
 }
 
 void OnnxModel::cleanup() {
+    if (api_) {
+        OrtValue** tensors[] = {&inputTensor_, &outputTensor_, &hiddenTensor_,
+                                &cellTensor_, &hiddenOutTensor_, &cellOutTensor_};
+        for (OrtValue** tensor : tensors) {
+            if (*tensor) {
+                api_->ReleaseValue(*tensor);
+                *tensor = nullptr;
+            }
+        }
+    }
+    boundFrames_ = 0;
+
     if (session_ && api_) {
         api_->ReleaseSession(session_);
         session_ = nullptr;
@@ -52,14 +63,68 @@ void OnnxModel::cleanup() {
 	isLoaded_ = false;
 }
 
+OrtValue* OnnxModel::wrapTensor(float* data, size_t count,
+                                const int64_t* shape, size_t numDims) {
+    OrtValue* value = nullptr;
+    OrtStatus* status = api_->CreateTensorWithDataAsOrtValue(
+        OnnxRuntime::instance().memoryInfo(),
+        data,
+        count * sizeof(float),
+        shape, numDims,
+        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+        &value
+    );
+    if (status) {
+        LOGE("CreateTensorWithDataAsOrtValue failed: %s\n", api_->GetErrorMessage(status));
+        api_->ReleaseStatus(status);
+        return nullptr;
+    }
+    return value;
+}
+
+bool OnnxModel::bindSequence(int numFrames) {
+    if (numFrames == boundFrames_) {
+        return true;
+    }
+
+    // Sequence length changed: rebind the input/output tensors over resized
+    // member buffers. Steady-state streaming uses a constant chunk size, so
+    // this is a one-time cost, not a per-call one.
+    if (inputTensor_) {
+        api_->ReleaseValue(inputTensor_);
+        inputTensor_ = nullptr;
+    }
+    if (outputTensor_) {
+        api_->ReleaseValue(outputTensor_);
+        outputTensor_ = nullptr;
+    }
+    boundFrames_ = 0;
+
+    inputData_.resize(static_cast<size_t>(numFrames) * INPUT_DIM);
+    outputData_.resize(static_cast<size_t>(numFrames) * OUTPUT_CLASSES);
+
+    const int64_t inputShape[] = {1, numFrames, INPUT_DIM};
+    const int64_t outputShape[] = {1, numFrames, OUTPUT_CLASSES};
+    inputTensor_ = wrapTensor(inputData_.data(), inputData_.size(), inputShape, 3);
+    outputTensor_ = wrapTensor(outputData_.data(), outputData_.size(), outputShape, 3);
+    if (!inputTensor_ || !outputTensor_) {
+        return false;
+    }
+
+    boundFrames_ = numFrames;
+    return true;
+}
+
 void OnnxModel::initializeLstmState() {
     std::fill(hidden_.begin(), hidden_.end(), 0.0f);
     std::fill(cell_.begin(), cell_.end(), 0.0f);
 }
 
-bool OnnxModel::load(const std::string& modelPath) {
+bool OnnxModel::load(const std::string& modelPath, ModelPrecision precision) {
 	cleanup();
 
+	const std::string resolved = resolveModelPath(modelPath, precision);
+
 	auto& runtime = OnnxRuntime::instance();
 	if (!runtime.isInitialized()) {
 		LOGE("ONNX Runtime not initialized\n");
@@ -78,33 +143,26 @@ bool OnnxModel::load(const std::string& modelPath) {
         return false;
     }
 
-    (void)api_->SetSessionGraphOptimizationLevel(sessionOptions_, ORT_ENABLE_ALL);
+    // Shared provider/thread/optimization tuning (falls back to CPU when
+    // the configured provider is unavailable)
+    runtime.configureSessionOptions(sessionOptions_);
 
-    // Enable hardware acceleration based on platform
-#ifdef __ANDROID__
-    // Try to enable NNAPI for Android - uses GPU/DSP/NPU when available
-    OrtSessionOptionsAppendExecutionProvider_Nnapi(sessionOptions_, 0);
-    LOGI("NNAPI execution provider enabled\n");
-#elif defined(__APPLE__) && defined(ONNX_ENABLE_COREML)
-    // Enable CoreML for iOS/macOS - uses Neural Engine on supported devices
-    // Flags:
-    //   0x001 = COREML_FLAG_CREATE_MLPROGRAM (use ML Program format, iOS 15+)
-    //   0x004 = COREML_FLAG_ONLY_ENABLE_DEVICE_WITH_ANE (require Neural Engine)
-    // We use 0x001 for ML Program which is more efficient on modern devices
-    uint32_t coremlFlags = 0x001;  // COREML_FLAG_CREATE_MLPROGRAM
-    OrtStatus* coremlStatus = OrtSessionOptionsAppendExecutionProvider_CoreML(sessionOptions_, coremlFlags);
-    if (coremlStatus) {
-        LOGI("CoreML not available: %s. Falling back to CPU\n", api_->GetErrorMessage(coremlStatus));
-        api_->ReleaseStatus(coremlStatus);
-    } else {
-        LOGI("CoreML execution provider enabled (ML Program mode)\n");
-    }
-#else
-    LOGI("Using CPU execution provider\n");
-#endif
+    // Load the cached optimized graph when one exists, else arrange for it
+    // to be serialized while this session is created
+    std::string sessionPath;
+    const bool fromCache = runtime.applyModelCache(sessionOptions_, resolved, sessionPath);
 
 	// Create session
-	status = api_->CreateSession(runtime.env(), modelPath.c_str(), sessionOptions_, &session_);
+	status = api_->CreateSession(runtime.env(), sessionPath.c_str(), sessionOptions_, &session_);
+	if (status && fromCache) {
+		// Stale or corrupt cache entry - drop it and load the raw model
+		LOGE("Cached model rejected: %s. Reloading raw model\n",
+		     api_->GetErrorMessage(status));
+		api_->ReleaseStatus(status);
+		std::remove(sessionPath.c_str());
+		runtime.configureSessionOptions(sessionOptions_);
+		status = api_->CreateSession(runtime.env(), resolved.c_str(), sessionOptions_, &session_);
+	}
 	if (status) {
 		LOGE("CreateSession failed: %s\n", api_->GetErrorMessage(status));
         api_->ReleaseStatus(status);
@@ -112,10 +170,24 @@ bool OnnxModel::load(const std::string& modelPath) {
         return false;
     }
 
+    // Pre-bind the fixed-shape LSTM state tensors over member buffers so
+    // steady-state inference performs no per-call tensor creation
+    hiddenOut_.resize(hidden_.size(), 0.0f);
+    cellOut_.resize(cell_.size(), 0.0f);
+    const int64_t hiddenShape[] = {NUM_LAYERS, 1, HIDDEN_DIM};
+    hiddenTensor_ = wrapTensor(hidden_.data(), hidden_.size(), hiddenShape, 3);
+    cellTensor_ = wrapTensor(cell_.data(), cell_.size(), hiddenShape, 3);
+    hiddenOutTensor_ = wrapTensor(hiddenOut_.data(), hiddenOut_.size(), hiddenShape, 3);
+    cellOutTensor_ = wrapTensor(cellOut_.data(), cellOut_.size(), hiddenShape, 3);
+    if (!hiddenTensor_ || !cellTensor_ || !hiddenOutTensor_ || !cellOutTensor_) {
+        cleanup();
+        return false;
+    }
+
     isLoaded_ = true;
     initializeLstmState();
 
-    LOGI("Model loaded successfully from: %s\n", modelPath.c_str());
+    LOGI("Model loaded successfully from: %s\n", resolved.c_str());
     return true;
 }
 
@@ -127,164 +199,100 @@ void OnnxModel::resetState() {
     initializeLstmState();
 }
 
-bool OnnxModel::infer(const float* features, ModelOutput& output) {
-	if (!isReady()) {
-		return false;
-	}
-	auto& runtime = OnnxRuntime::instance();
-	if (!runtime.isInitialized()) {
-		return false;
-	}
-
-	OrtStatus* status = nullptr;
-
-    // Input shapes
-    const int64_t inputShape[] = {1, 1, INPUT_DIM};          // [batch, seq, features]
-    const int64_t hiddenShape[] = {NUM_LAYERS, 1, HIDDEN_DIM}; // [layers, batch, hidden]
-
-    // Create input tensors
-    OrtValue* inputTensor = nullptr;
-    OrtValue* hiddenTensor = nullptr;
-    OrtValue* cellTensor = nullptr;
-
-	status = api_->CreateTensorWithDataAsOrtValue(
-		runtime.memoryInfo(),
-		const_cast<float*>(features),
-		INPUT_DIM * sizeof(float),
-        inputShape, 3,
-        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
-        &inputTensor
-    );
-    if (status) {
-        LOGE("CreateTensorWithDataAsOrtValue (input) failed: %s\n", api_->GetErrorMessage(status));
-        api_->ReleaseStatus(status);
+bool OnnxModel::getLstmState(std::vector<float>& hidden, std::vector<float>& cell) const {
+    if (!isLoaded_) {
         return false;
     }
+    hidden = hidden_;
+    cell = cell_;
+    return true;
+}
 
-	status = api_->CreateTensorWithDataAsOrtValue(
-		runtime.memoryInfo(),
-		hidden_.data(),
-        hidden_.size() * sizeof(float),
-        hiddenShape, 3,
-        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
-        &hiddenTensor
-    );
-    if (status) {
-        LOGE("CreateTensorWithDataAsOrtValue (hidden) failed: %s\n", api_->GetErrorMessage(status));
-        api_->ReleaseStatus(status);
-        api_->ReleaseValue(inputTensor);
+bool OnnxModel::setLstmState(const std::vector<float>& hidden, const std::vector<float>& cell) {
+    if (!isLoaded_ || hidden.size() != hidden_.size() || cell.size() != cell_.size()) {
         return false;
     }
+    // The pre-bound state tensors wrap hidden_/cell_ data pointers, so the
+    // copy must not reallocate the vectors
+    std::copy(hidden.begin(), hidden.end(), hidden_.begin());
+    std::copy(cell.begin(), cell.end(), cell_.begin());
+    return true;
+}
 
-	status = api_->CreateTensorWithDataAsOrtValue(
-		runtime.memoryInfo(),
-		cell_.data(),
-        cell_.size() * sizeof(float),
-        hiddenShape, 3,
-        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
-        &cellTensor
-    );
-    if (status) {
-        LOGE("CreateTensorWithDataAsOrtValue (cell) failed: %s\n", api_->GetErrorMessage(status));
-        api_->ReleaseStatus(status);
-        api_->ReleaseValue(inputTensor);
-        api_->ReleaseValue(hiddenTensor);
-        return false;
+/**
+ * Convert one frame of raw model logits/probabilities to activations,
+ * applying softmax only when the outputs are not already normalized
+ */
+static void extractActivations(const float* frame, ModelOutput& output) {
+    float sum = frame[0] + frame[1] + frame[2];
+    float probs[3];
+
+    if (std::abs(sum - 1.0f) > 0.01f) {
+        // Not normalized, apply softmax
+        float maxVal = std::max({frame[0], frame[1], frame[2]});
+        float exp0 = std::exp(frame[0] - maxVal);
+        float exp1 = std::exp(frame[1] - maxVal);
+        float exp2 = std::exp(frame[2] - maxVal);
+        float expSum = exp0 + exp1 + exp2;
+        probs[0] = exp0 / expSum;
+        probs[1] = exp1 / expSum;
+        probs[2] = exp2 / expSum;
+    } else {
+        probs[0] = frame[0];
+        probs[1] = frame[1];
+        probs[2] = frame[2];
     }
 
-    // Set up inputs array
-    OrtValue* inputs[] = {inputTensor, hiddenTensor, cellTensor};
+    // Output order: [beat, downbeat, non-beat]
+    output.beatActivation = probs[0];
+    output.downbeatActivation = probs[1];
+}
 
-    // Allocate output tensors (will be filled by Run)
-    OrtValue* outputs[3] = {nullptr, nullptr, nullptr};
+bool OnnxModel::infer(const float* features, ModelOutput& output) {
+    return inferSequence(features, 1, &output);
+}
+
+bool OnnxModel::inferSequence(const float* features, int numFrames, ModelOutput* outputs) {
+	if (!isReady() || numFrames <= 0) {
+		return false;
+	}
+	auto& runtime = OnnxRuntime::instance();
+	if (!runtime.isInitialized()) {
+		return false;
+	}
+	if (!bindSequence(numFrames)) {
+		return false;
+	}
+
+    // Stage the features into the pre-bound input buffer; every tensor the
+    // session touches below wraps memory this object owns
+    std::memcpy(inputData_.data(), features, inputData_.size() * sizeof(float));
+
+    OrtValue* inputs[] = {inputTensor_, hiddenTensor_, cellTensor_};
+    OrtValue* outputValues[] = {outputTensor_, hiddenOutTensor_, cellOutTensor_};
 
     // Run inference
-    status = api_->Run(
+    OrtStatus* status = api_->Run(
         session_,
         nullptr,  // run options
         inputNames_.data(), inputs, 3,
-        outputNames_.data(), 3, outputs
+        outputNames_.data(), 3, outputValues
     );
 
-    // Clean up input tensors
-    api_->ReleaseValue(inputTensor);
-    api_->ReleaseValue(hiddenTensor);
-    api_->ReleaseValue(cellTensor);
-
     if (status) {
         LOGE("Run failed: %s\n", api_->GetErrorMessage(status));
         api_->ReleaseStatus(status);
         return false;
     }
 
-    // Extract output probabilities
-    float* outputData = nullptr;
-    status = api_->GetTensorMutableData(outputs[0], (void**)&outputData);
-    if (status || !outputData) {
-        if (status) {
-            LOGE("GetTensorMutableData (output) failed: %s\n", api_->GetErrorMessage(status));
-            api_->ReleaseStatus(status);
-        }
-        for (int i = 0; i < 3; i++) {
-            if (outputs[i]) api_->ReleaseValue(outputs[i]);
-        }
-        return false;
-    }
-
-	float* hiddenOut = nullptr;
-	float* cellOut = nullptr;
-	OrtStatus* hiddenStatus = api_->GetTensorMutableData(outputs[1], (void**)&hiddenOut);
-	OrtStatus* cellStatus = api_->GetTensorMutableData(outputs[2], (void**)&cellOut);
-
-	if (hiddenStatus) {
-		LOGE(
-			"GetTensorMutableData (hidden_out) failed: %s\n",
-			api_->GetErrorMessage(hiddenStatus)
-		);
-		api_->ReleaseStatus(hiddenStatus);
-	}
-	if (cellStatus) {
-		LOGE(
-			"GetTensorMutableData (cell_out) failed: %s\n",
-			api_->GetErrorMessage(cellStatus)
-		);
-		api_->ReleaseStatus(cellStatus);
-	}
-
-    if (hiddenOut) {
-        std::memcpy(hidden_.data(), hiddenOut, hidden_.size() * sizeof(float));
-    }
-    if (cellOut) {
-        std::memcpy(cell_.data(), cellOut, cell_.size() * sizeof(float));
-    }
-
-    // Apply softmax if needed (check if output is already normalized)
-    float sum = outputData[0] + outputData[1] + outputData[2];
-    float probs[3];
-
-    if (std::abs(sum - 1.0f) > 0.01f) {
-        // Not normalized, apply softmax
-        float maxVal = std::max({outputData[0], outputData[1], outputData[2]});
-        float exp0 = std::exp(outputData[0] - maxVal);
-        float exp1 = std::exp(outputData[1] - maxVal);
-        float exp2 = std::exp(outputData[2] - maxVal);
-        float expSum = exp0 + exp1 + exp2;
-        probs[0] = exp0 / expSum;
-        probs[1] = exp1 / expSum;
-        probs[2] = exp2 / expSum;
-    } else {
-        probs[0] = outputData[0];
-        probs[1] = outputData[1];
-        probs[2] = outputData[2];
-    }
-
-    // Output order: [beat, downbeat, non-beat]
-    output.beatActivation = probs[0];
-    output.downbeatActivation = probs[1];
+    // Run wrote the new LSTM state into the bound output buffers; carry it
+    // over as the next call's input state
+    std::memcpy(hidden_.data(), hiddenOut_.data(), hidden_.size() * sizeof(float));
+    std::memcpy(cell_.data(), cellOut_.data(), cell_.size() * sizeof(float));
 
-    // Clean up output tensors
-    for (int i = 0; i < 3; i++) {
-        if (outputs[i]) api_->ReleaseValue(outputs[i]);
+    // Output is [1, numFrames, 3]; convert each frame to activations
+    for (int i = 0; i < numFrames; i++) {
+        extractActivations(outputData_.data() + i * OUTPUT_CLASSES, outputs[i]);
     }
 
     return true;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "ModelPrecision.hpp"
+
 #ifdef ONNX_ENABLED
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,11 +31,14 @@ struct ModelOutput {
  * ONNX Runtime wrapper for BeatNet CRNN model
  *
  * Model Architecture:
- * - Input: [1, 1, 272] mel features (batch=1, seq=1, features=272)
+ * - Input: [1, N, 272] mel features (batch=1, seq=N, features=272)
  * - Hidden/Cell: [2, 1, 150] LSTM state
- * - Output: [1, 1, 3] probabilities [beat, downbeat, non-beat]
+ * - Output: [1, N, 3] probabilities [beat, downbeat, non-beat]
  *
  * Maintains LSTM hidden state between inference calls for streaming.
+ * Frames can be batched into one Run call (the sequence axis is dynamic),
+ * which amortizes ONNX Runtime's per-call overhead - significant for a
+ * 150-unit LSTM where the dispatch costs more than the math.
  */
 class OnnxModel {
 public:
@@ -45,10 +51,13 @@ public:
 
     /**
      * Load model from file path
-     * @param modelPath Path to .onnx model file
+     * @param modelPath Path to the float32 .onnx model file
+     * @param precision Requested precision; resolves to a quantized sibling
+     *                  (beatnet.int8.onnx) when one is shipped, else float32
      * @return true if loaded successfully
      */
-    bool load(const std::string& modelPath);
+    bool load(const std::string& modelPath,
+              ModelPrecision precision = ModelPrecision::Auto);
 
     /**
      * Check if model is loaded and ready
@@ -68,6 +77,27 @@ public:
      */
     bool infer(const float* features, ModelOutput& output);
 
+    /**
+     * Run inference on a sequence of stacked mel feature frames
+     * @param features numFrames * 272 floats, frame-major
+     * @param numFrames Number of frames in the sequence
+     * @param outputs Output activations, one entry per frame
+     * @return true if inference succeeded
+     */
+    bool inferSequence(const float* features, int numFrames, ModelOutput* outputs);
+
+    /**
+     * Copy the LSTM hidden/cell state out for serialization
+     * @return false if no model is loaded
+     */
+    bool getLstmState(std::vector<float>& hidden, std::vector<float>& cell) const;
+
+    /**
+     * Restore LSTM state captured by getLstmState
+     * @return false if no model is loaded or the sizes do not match
+     */
+    bool setLstmState(const std::vector<float>& hidden, const std::vector<float>& cell);
+
     // Constants matching the model architecture
     static constexpr int INPUT_DIM = 272;
     static constexpr int HIDDEN_DIM = 150;
@@ -77,6 +107,8 @@ public:
 private:
     void cleanup();
     void initializeLstmState();
+    OrtValue* wrapTensor(float* data, size_t count, const std::int64_t* shape, size_t numDims);
+    bool bindSequence(int numFrames);
 
 	const OrtApi* api_ = nullptr;
 	OrtSession* session_ = nullptr;
@@ -86,6 +118,22 @@ private:
     std::vector<float> hidden_;
     std::vector<float> cell_;
 
+    // Persistent pre-bound tensors wrapping the buffers below. The state
+    // tensors are created once in load(); the input/output pair is rebound
+    // only when the sequence length changes.
+    OrtValue* inputTensor_ = nullptr;
+    OrtValue* outputTensor_ = nullptr;
+    OrtValue* hiddenTensor_ = nullptr;
+    OrtValue* cellTensor_ = nullptr;
+    OrtValue* hiddenOutTensor_ = nullptr;
+    OrtValue* cellOutTensor_ = nullptr;
+    int boundFrames_ = 0;
+
+    std::vector<float> inputData_;
+    std::vector<float> outputData_;
+    std::vector<float> hiddenOut_;
+    std::vector<float> cellOut_;
+
     // Input/output names
     std::vector<const char*> inputNames_;
     std::vector<const char*> outputNames_;
@@ -110,10 +158,13 @@ public:
     OnnxModel() = default;
     ~OnnxModel() = default;
 
-    bool load(const std::string&) { return false; }
+    bool load(const std::string&, ModelPrecision = ModelPrecision::Auto) { return false; }
     bool isReady() const { return false; }
     void resetState() {}
     bool infer(const float*, ModelOutput&) { return false; }
+    bool inferSequence(const float*, int, ModelOutput*) { return false; }
+    bool getLstmState(std::vector<float>&, std::vector<float>&) const { return false; }
+    bool setLstmState(const std::vector<float>&, const std::vector<float>&) { return false; }
 
     static constexpr int INPUT_DIM = 272;
     static constexpr int HIDDEN_DIM = 150;
@@ -8,6 +8,13 @@
 
 #include "OnnxRuntime.hpp"
 #include <onnxruntime_c_api.h>
+#ifdef __ANDROID__
+#include <nnapi_provider_factory.h>
+#endif
+#ifdef ONNX_ENABLE_COREML
+#include <coreml_provider_factory.h>
+#endif
+#include <cstdio>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -50,11 +57,25 @@ bool OnnxRuntime::initialize() {
 
 	OrtStatus* status = nullptr;
 
-	// Create shared environment
-	status = api_->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "KeyedEngine", &env_);
+	// Create the shared environment with a process-wide global thread pool.
+	// Sessions that do not request a private intra-op count attach to this
+	// pool (see configureSessionOptions), so pooled Engines share one fixed
+	// set of worker threads instead of each session spinning up its own.
+	// Default thread options size the pool to the core count.
+	OrtThreadingOptions* threadingOptions = nullptr;
+	status = api_->CreateThreadingOptions(&threadingOptions);
 	if (status != nullptr) {
 		const char* msg = api_->GetErrorMessage(status);
-		LOGE("CreateEnv failed: %s\n", msg);
+		LOGE("CreateThreadingOptions failed: %s\n", msg);
+		api_->ReleaseStatus(status);
+		return false;
+	}
+	status = api_->CreateEnvWithGlobalThreadPools(
+		ORT_LOGGING_LEVEL_WARNING, "KeyedEngine", threadingOptions, &env_);
+	api_->ReleaseThreadingOptions(threadingOptions);
+	if (status != nullptr) {
+		const char* msg = api_->GetErrorMessage(status);
+		LOGE("CreateEnvWithGlobalThreadPools failed: %s\n", msg);
 		api_->ReleaseStatus(status);
 		return false;
 	}
@@ -72,6 +93,170 @@ bool OnnxRuntime::initialize() {
 	return true;
 }
 
+bool OnnxRuntime::configureSessionOptions(OrtSessionOptions* options) const {
+	if (!initialized_ || options == nullptr) {
+		return false;
+	}
+
+	GraphOptimizationLevel level = ORT_ENABLE_ALL;
+	switch (config_.optLevel) {
+	case SessionConfig::OptLevel::Disabled: level = ORT_DISABLE_ALL; break;
+	case SessionConfig::OptLevel::Basic:    level = ORT_ENABLE_BASIC; break;
+	case SessionConfig::OptLevel::Extended: level = ORT_ENABLE_EXTENDED; break;
+	case SessionConfig::OptLevel::All:      level = ORT_ENABLE_ALL; break;
+	}
+	(void)api_->SetSessionGraphOptimizationLevel(options, level);
+
+	if (config_.intraOpThreads > 0) {
+		// Explicit override: this session keeps a private pool of the
+		// requested size instead of the shared one
+		(void)api_->SetIntraOpNumThreads(options, config_.intraOpThreads);
+	} else {
+		// Attach the session to the environment's global thread pool
+		(void)api_->DisablePerSessionThreads(options);
+	}
+
+	// Resolve Auto to the platform default provider
+	SessionConfig::Provider provider = config_.provider;
+	if (provider == SessionConfig::Provider::Auto) {
+#if defined(__ANDROID__)
+		provider = SessionConfig::Provider::Nnapi;
+#elif defined(ONNX_ENABLE_COREML)
+		provider = SessionConfig::Provider::CoreMl;
+#else
+		provider = SessionConfig::Provider::Cpu;
+#endif
+	}
+
+	// Provider setup is best-effort: a failed append is logged and dropped
+	// so the session falls back to plain CPU kernels
+	OrtStatus* status = nullptr;
+	switch (provider) {
+	case SessionConfig::Provider::Nnapi:
+#if defined(__ANDROID__)
+		status = OrtSessionOptionsAppendExecutionProvider_Nnapi(options, 0);
+		if (status == nullptr) {
+			LOGI("NNAPI execution provider enabled\n");
+		}
+#else
+		LOGE("NNAPI requested on non-Android platform, using CPU\n");
+#endif
+		break;
+
+	case SessionConfig::Provider::CoreMl:
+#if defined(ONNX_ENABLE_COREML)
+		// MLProgram format (iOS 15+) on CPU+GPU; static-shape restriction
+		// stays off because MusicalKeyCNN uses variable-length input
+		status = OrtSessionOptionsAppendExecutionProvider_CoreML(
+			options, COREML_FLAG_CREATE_MLPROGRAM | COREML_FLAG_USE_CPU_AND_GPU);
+		if (status == nullptr) {
+			LOGI("CoreML execution provider enabled (MLProgram, CPU+GPU)\n");
+		}
+#else
+		LOGE("CoreML requested but not compiled in, using CPU\n");
+#endif
+		break;
+
+	case SessionConfig::Provider::Xnnpack: {
+		// XNNPACK takes its thread pool size as a provider option
+		const char* keys[] = {"intra_op_num_threads"};
+		char threads[16];
+		snprintf(threads, sizeof(threads), "%d",
+		         config_.intraOpThreads > 0 ? config_.intraOpThreads : 1);
+		const char* values[] = {threads};
+		status = api_->SessionOptionsAppendExecutionProvider(
+			options, "XNNPACK", keys, values, 1);
+		if (status == nullptr) {
+			LOGI("XNNPACK execution provider enabled (%s threads)\n", threads);
+		}
+		break;
+	}
+
+	case SessionConfig::Provider::Cpu:
+	case SessionConfig::Provider::Auto:
+		LOGI("Using CPU execution provider\n");
+		break;
+	}
+
+	if (status != nullptr) {
+		LOGI("Execution provider unavailable: %s. Falling back to CPU\n",
+		     api_->GetErrorMessage(status));
+		api_->ReleaseStatus(status);
+	}
+
+	return true;
+}
+
+namespace {
+
+/** Size of a file in bytes, or 0 when it cannot be opened */
+long fileSize(const std::string& path) {
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file) {
+		return 0;
+	}
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+/** Model file name without directory or .onnx extension */
+std::string modelStem(const std::string& path) {
+	const size_t slash = path.rfind('/');
+	const size_t start = slash == std::string::npos ? 0 : slash + 1;
+	size_t end = path.rfind('.');
+	if (end == std::string::npos || end < start) {
+		end = path.size();
+	}
+	return path.substr(start, end - start);
+}
+
+} // namespace
+
+bool OnnxRuntime::applyModelCache(OrtSessionOptions* options, const std::string& modelPath,
+                                  std::string& sourcePath) const {
+	sourcePath = modelPath;
+	if (!initialized_ || options == nullptr || cacheDir_.empty()) {
+		return false;
+	}
+
+	const long rawSize = fileSize(modelPath);
+	if (rawSize <= 0) {
+		return false;
+	}
+
+	// The name doubles as the invalidation key: an ORT upgrade or a model
+	// update produces a different name and the stale entry is simply unused
+	const std::string stem = modelStem(modelPath);
+	const std::string key = stem + ".ort" + OrtGetApiBase()->GetVersionString()
+	                        + "." + std::to_string(rawSize);
+	const std::string cached = cacheDir_ + "/" + key + ".opt.onnx";
+	const std::string weights = key + ".opt.weights";
+
+	if (fileSize(cached) > 0) {
+		// Cached graph is already optimized - skip the optimizer entirely.
+		// Its large initializers live in the external weights file beside
+		// it, which ORT memory-maps instead of copying on load.
+		(void)api_->SetSessionGraphOptimizationLevel(options, ORT_DISABLE_ALL);
+		sourcePath = cached;
+		LOGI("Loading optimized model cache: %s\n", cached.c_str());
+		return true;
+	}
+
+	// First run: serialize the optimized graph during session creation,
+	// splitting initializers over 1KB into the mappable external file
+	(void)api_->SetOptimizedModelFilePath(options, cached.c_str());
+	(void)api_->AddSessionConfigEntry(
+		options, "session.optimized_model_external_initializers_file_name",
+		weights.c_str());
+	(void)api_->AddSessionConfigEntry(
+		options, "session.optimized_model_external_initializers_min_size_in_bytes",
+		"1024");
+	LOGI("Writing optimized model cache: %s\n", cached.c_str());
+	return false;
+}
+
 void OnnxRuntime::cleanup() {
 	if (memoryInfo_ && api_) {
 		api_->ReleaseMemoryInfo(memoryInfo_);
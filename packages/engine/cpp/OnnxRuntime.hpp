@@ -1,11 +1,14 @@
 #pragma once
 
+#include <string>
+
 #ifdef ONNX_ENABLED
 
 // Forward declare ONNX Runtime types
 struct OrtApi;
 struct OrtEnv;
 struct OrtMemoryInfo;
+struct OrtSessionOptions;
 
 namespace engine {
 
@@ -18,15 +21,84 @@ namespace engine {
  * Benefits:
  * - Single initialization of ONNX Runtime
  * - Shared memory allocator
+ * - One global inference thread pool: sessions attach to it instead of
+ *   each creating their own, so a process pooling many Engines (library
+ *   scanning) holds a fixed set of worker threads rather than one pool
+ *   per session fighting over cores
  * - Reduced memory footprint
  */
 class OnnxRuntime {
 public:
+	/**
+	 * Per-session tuning applied to every OrtSessionOptions the engine
+	 * creates. Set once via setSessionConfig() before loading models;
+	 * OnnxModel::load and KeyModel::load both pick it up through
+	 * configureSessionOptions(), so the two models stay consistent.
+	 */
+	struct SessionConfig {
+		enum class Provider {
+			Auto,     // NNAPI on Android, CoreML on Apple, CPU elsewhere
+			Cpu,      // No execution provider - plain CPU kernels
+			Nnapi,    // Android NNAPI (GPU/DSP/NPU)
+			CoreMl,   // Apple CoreML (Neural Engine / GPU)
+			Xnnpack,  // XNNPACK CPU kernels (fast on ARM)
+		};
+		enum class OptLevel { Disabled, Basic, Extended, All };
+
+		Provider provider = Provider::Auto;
+		OptLevel optLevel = OptLevel::All;
+		// 0 attaches the session to the environment's shared global thread
+		// pool; >0 gives it a private pool of that size instead
+		int intraOpThreads = 0;
+	};
+
 	/**
 	 * Get singleton instance
 	 */
 	static OnnxRuntime& instance();
 
+	/**
+	 * Replace the session config (affects models loaded afterwards)
+	 */
+	void setSessionConfig(const SessionConfig& config) { config_ = config; }
+
+	/**
+	 * Get the active session config
+	 */
+	const SessionConfig& sessionConfig() const { return config_; }
+
+	/**
+	 * Apply the session config to freshly created session options:
+	 * graph optimization level, intra-op thread count and the execution
+	 * provider. A provider that fails to initialize is logged and dropped
+	 * so the session falls back to plain CPU rather than failing the load.
+	 * @return true if the core options were applied
+	 */
+	bool configureSessionOptions(OrtSessionOptions* options) const;
+
+	/**
+	 * Set directory for cached optimized graphs (e.g. app storage on
+	 * mobile). First load of a model serializes ORT's optimized graph
+	 * there with large weights split into an external file that ORT
+	 * memory-maps on reload; later loads skip graph optimization
+	 * entirely. Empty disables caching (default). Call before loading
+	 * models. Cache names embed the ORT version and model size, so a
+	 * model or runtime update invalidates stale entries by construction.
+	 */
+	void setOptimizedModelCachePath(const std::string& dir) { cacheDir_ = dir; }
+
+	/**
+	 * Route session creation through the optimized-model cache.
+	 * With a cache hit, disables graph optimization on the options and
+	 * points sourcePath at the cached graph; on a miss, arranges for the
+	 * optimized graph to be serialized during session creation.
+	 * @param modelPath Path to the model file being loaded
+	 * @param sourcePath Out: the path CreateSession should be given
+	 * @return true when sourcePath refers to the cached optimized graph
+	 */
+	bool applyModelCache(OrtSessionOptions* options, const std::string& modelPath,
+	                     std::string& sourcePath) const;
+
 	/**
 	 * Get ONNX Runtime API
 	 */
@@ -61,6 +133,8 @@ private:
 	const OrtApi* api_ = nullptr;
 	OrtEnv* env_ = nullptr;
 	OrtMemoryInfo* memoryInfo_ = nullptr;
+	SessionConfig config_;
+	std::string cacheDir_;
 	bool initialized_ = false;
 };
 
@@ -73,11 +147,25 @@ namespace engine {
 
 class OnnxRuntime {
 public:
+	struct SessionConfig {
+		enum class Provider { Auto, Cpu, Nnapi, CoreMl, Xnnpack };
+		enum class OptLevel { Disabled, Basic, Extended, All };
+
+		Provider provider = Provider::Auto;
+		OptLevel optLevel = OptLevel::All;
+		int intraOpThreads = 0;
+	};
+
 	static OnnxRuntime& instance() {
 		static OnnxRuntime inst;
 		return inst;
 	}
 
+	void setSessionConfig(const SessionConfig& config) { config_ = config; }
+	const SessionConfig& sessionConfig() const { return config_; }
+	bool configureSessionOptions(void*) const { return false; }
+	void setOptimizedModelCachePath(const std::string&) {}
+
 	const void* api() const { return nullptr; }
 	void* env() const { return nullptr; }
 	void* memoryInfo() const { return nullptr; }
@@ -85,6 +173,8 @@ public:
 
 private:
 	OnnxRuntime() = default;
+
+	SessionConfig config_;
 };
 
 } // namespace engine
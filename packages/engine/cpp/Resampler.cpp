@@ -1,20 +1,75 @@
 /**
  * Audio Resampler Implementation
  *
- * Implements 2:1 downsampling using a windowed sinc low-pass filter.
+ * Integer-ratio downsampling via windowed sinc FIR decimation, plus a
+ * rational L/M polyphase mode for 48 kHz capture rates.
  */
 
 #include "Resampler.hpp"
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <stdexcept>
 
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 namespace engine {
 
+/**
+ * Contiguous FIR dot product. Maps onto vDSP/NEON/AVX like the CQT
+ * correlators; the scalar fallback auto-vectorizes.
+ */
+static float firDot(const float* x, const float* h, int len) {
+#if defined(__APPLE__)
+	float sum = 0.0f;
+	vDSP_dotpr(x, 1, h, 1, &sum, static_cast<vDSP_Length>(len));
+	return sum;
+#elif defined(__ARM_NEON)
+	float32x4_t acc = vdupq_n_f32(0.0f);
+	int n = 0;
+	for (; n + 4 <= len; n += 4) {
+		acc = vmlaq_f32(acc, vld1q_f32(x + n), vld1q_f32(h + n));
+	}
+	float sum = vaddvq_f32(acc);
+	for (; n < len; n++) {
+		sum += x[n] * h[n];
+	}
+	return sum;
+#elif defined(__AVX__)
+	__m256 acc = _mm256_setzero_ps();
+	int n = 0;
+	for (; n + 8 <= len; n += 8) {
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(x + n), _mm256_loadu_ps(h + n)));
+	}
+	alignas(32) float lanes[8];
+	_mm256_store_ps(lanes, acc);
+	float sum = 0.0f;
+	for (int j = 0; j < 8; j++) {
+		sum += lanes[j];
+	}
+	for (; n < len; n++) {
+		sum += x[n] * h[n];
+	}
+	return sum;
+#else
+	float sum = 0.0f;
+	for (int n = 0; n < len; n++) {
+		sum += x[n] * h[n];
+	}
+	return sum;
+#endif
+}
+
 // Generate windowed sinc low-pass filter coefficients
 static std::vector<float> generateSincFilter(int length, float cutoff) {
 	std::vector<float> coeffs(length);
@@ -57,51 +112,120 @@ Resampler::Resampler(int inputRate, int outputRate)
 	if (inputRate_ <= 0 || outputRate_ <= 0) {
 		throw std::invalid_argument("Resampler sample rates must be positive");
 	}
-	if (inputRate_ % outputRate_ != 0 || ratio_ != RATIO) {
-		throw std::invalid_argument("Resampler only supports 2:1 downsampling (44100 -> 22050)");
+	if (outputRate_ > inputRate_) {
+		throw std::invalid_argument("Resampler only downsamples");
 	}
 
-	// Generate low-pass filter with cutoff below new Nyquist
-	// For 2:1 downsample: new Nyquist is at 0.5 of input, so cutoff at ~0.45
-	// The sinc cutoff parameter is normalized to 2.0 = Nyquist of input
-	// So 0.9 means 0.9 * (fs_out / fs_in) = 0.9 * 0.5 = 0.45 of input Nyquist
-	// Use 127 taps for better stopband attenuation (>60dB)
-	filterLength_ = 127;
-	float cutoff = 0.9f / ratio_;  // 0.45 for 2:1 ratio
-	coefficients_ = generateSincFilter(filterLength_, cutoff);
+	if (inputRate_ % outputRate_ == 0) {
+		// Integer decimation. Low-pass cutoff below the new Nyquist:
+		// the sinc cutoff parameter is normalized so 1.0 = input Nyquist,
+		// so 0.9 / ratio leaves a 10% transition margin (0.45 for 2:1).
+		// Use 127 taps for better stopband attenuation (>60dB)
+		filterLength_ = 127;
+		float cutoff = 0.9f / ratio_;
+		coefficients_ = generateSincFilter(filterLength_, cutoff);
+		historySize_ = filterLength_ - 1;
+	} else {
+		// Rational L/M polyphase (48000 -> 44100 is 147:160). The prototype
+		// filter runs at the upsampled rate fs_in * L; its cutoff sits
+		// below the tighter of the two Nyquists with the same 10% margin
+		const int g = std::gcd(inputRate_, outputRate_);
+		upFactor_ = outputRate_ / g;
+		downFactor_ = inputRate_ / g;
+		ratio_ = 1;
+		tapsPerPhase_ = 24;
+		filterLength_ = upFactor_ * tapsPerPhase_;
+		float cutoff = 0.9f / static_cast<float>(std::max(upFactor_, downFactor_));
+		coefficients_ = generateSincFilter(filterLength_, cutoff);
+
+		// Split the prototype into L phases, each reversed so the inner
+		// loop is one contiguous dot product against the sample history.
+		// Gain L compensates for the zeros the polyphase structure skips
+		phases_.resize(static_cast<size_t>(upFactor_) * tapsPerPhase_);
+		for (int p = 0; p < upFactor_; p++) {
+			for (int k = 0; k < tapsPerPhase_; k++) {
+				phases_[p * tapsPerPhase_ + (tapsPerPhase_ - 1 - k)] =
+					static_cast<float>(upFactor_) * coefficients_[p + k * upFactor_];
+			}
+		}
+		historySize_ = tapsPerPhase_ - 1;
+	}
 
 	// Initialize history buffer for streaming
-	historySize_ = filterLength_ - 1;
 	history_.resize(historySize_, 0.0f);
 }
 
 int Resampler::getOutputSize(int inputSize) const {
-	return inputSize / ratio_;
+	if (upFactor_ == 1) {
+		return inputSize / ratio_;
+	}
+	return static_cast<int>(static_cast<int64_t>(inputSize) * upFactor_ / downFactor_);
 }
 
 int Resampler::getDelay() const {
-	return (filterLength_ / 2) / ratio_;
+	if (upFactor_ == 1) {
+		return (filterLength_ / 2) / ratio_;
+	}
+	return filterLength_ / (2 * downFactor_);
 }
 
 void Resampler::reset() {
 	std::fill(history_.begin(), history_.end(), 0.0f);
+	phaseAcc_ = 0;
+}
+
+void Resampler::saveState(StateWriter& w) const {
+	w.write(static_cast<int32_t>(inputRate_));
+	w.write(static_cast<int32_t>(outputRate_));
+	w.writeFloats(history_.data(), history_.size());
+	w.write(phaseAcc_);
+}
+
+bool Resampler::loadState(StateReader& r) {
+	return r.expect(static_cast<int32_t>(inputRate_)) &&
+	       r.expect(static_cast<int32_t>(outputRate_)) &&
+	       r.readFloats(history_.data(), history_.size()) &&
+	       r.read(phaseAcc_);
+}
+
+int Resampler::runPolyphase(const float* padded, int inputSize, float* output,
+                            int maxOutput, int64_t& t) {
+	// Output m lands at upsampled tick t = m * M (plus carry); its phase is
+	// t mod L and its newest input sample is t / L. The padded layout puts
+	// sample n's full tapsPerPhase_ window at padded[n .. n + taps - 1]
+	const int64_t limit = static_cast<int64_t>(inputSize) * upFactor_;
+	int outputIdx = 0;
+	while (t < limit && outputIdx < maxOutput) {
+		const int n = static_cast<int>(t / upFactor_);
+		const int p = static_cast<int>(t % upFactor_);
+		output[outputIdx++] = firDot(padded + n, &phases_[p * tapsPerPhase_], tapsPerPhase_);
+		t += downFactor_;
+	}
+
+	// If maxOutput cut the loop short, still advance past this buffer so
+	// the carried phase stays aligned with the history update
+	if (t < limit) {
+		t += ((limit - t + downFactor_ - 1) / downFactor_) * downFactor_;
+	}
+	return outputIdx;
 }
 
 int Resampler::process(const float* input, int inputSize, float* output) {
+	if (upFactor_ > 1) {
+		// Rational one-shot: zero pre-history, fresh phase
+		streamBuffer_.assign(historySize_, 0.0f);
+		streamBuffer_.insert(streamBuffer_.end(), input, input + inputSize);
+		int64_t t = 0;
+		return runPolyphase(streamBuffer_.data(), inputSize, output,
+		                    getOutputSize(inputSize), t);
+	}
+
 	const int halfLen = filterLength_ / 2;
 	int outputIdx = 0;
 
 	// Process each output sample (take every ratio'th filtered sample)
 	for (int n = halfLen; n < inputSize - halfLen; n += ratio_) {
-		float sum = 0.0f;
-
-		// Apply FIR filter
-		for (int k = 0; k < filterLength_; k++) {
-			int inputIdx = n - halfLen + k;
-			sum += input[inputIdx] * coefficients_[k];
-		}
-
-		output[outputIdx++] = sum;
+		output[outputIdx++] = firDot(input + n - halfLen, coefficients_.data(), filterLength_);
 	}
 
 	return outputIdx;
@@ -117,24 +241,25 @@ int Resampler::processStreaming(const float* input, int inputSize, float* output
 	// Append new input
 	std::copy(input, input + inputSize, streamBuffer_.begin() + historySize_);
 
-	const int halfLen = filterLength_ / 2;
 	int outputIdx = 0;
-
-	// Process starting from where we have full filter context
-	for (
-		int n = halfLen;
-		n < static_cast<int>(streamBuffer_.size()) - halfLen && outputIdx < maxOutputSize;
-		n += ratio_
-	) {
-		float sum = 0.0f;
-
-		// Apply FIR filter
-		for (int k = 0; k < filterLength_; k++) {
-			int inputIdx = n - halfLen + k;
-			sum += streamBuffer_[inputIdx] * coefficients_[k];
+	if (upFactor_ > 1) {
+		outputIdx = runPolyphase(streamBuffer_.data(), inputSize, output,
+		                         maxOutputSize, phaseAcc_);
+
+		// Re-base the carried tick position onto the next buffer
+		phaseAcc_ -= static_cast<int64_t>(inputSize) * upFactor_;
+	} else {
+		const int halfLen = filterLength_ / 2;
+
+		// Process starting from where we have full filter context
+		for (
+			int n = halfLen;
+			n < static_cast<int>(streamBuffer_.size()) - halfLen && outputIdx < maxOutputSize;
+			n += ratio_
+		) {
+			output[outputIdx++] = firDot(streamBuffer_.data() + n - halfLen,
+			                             coefficients_.data(), filterLength_);
 		}
-
-		output[outputIdx++] = sum;
 	}
 
 	// Update history with the last samples of the combined buffer
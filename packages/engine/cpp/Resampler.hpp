@@ -1,5 +1,7 @@
 #pragma once
 
+#include "StateBlob.hpp"
+#include <cstdint>
 #include <vector>
 
 namespace engine {
@@ -7,20 +9,25 @@ namespace engine {
 /**
  * Audio resampler for sample rate conversion
  *
- * Implements 2:1 downsampling (44100 Hz → 22050 Hz) using a polyphase
- * halfband filter for efficient, high-quality conversion.
+ * Integer ratios (44100 Hz → 22050 Hz) use direct FIR decimation with a
+ * windowed sinc low-pass. Rational ratios use a polyphase L/M structure:
+ * 48000 → 44100 is 147:160 and 48000 → 22050 is 147:320, so audio from
+ * 48 kHz capture devices reaches either pipeline rate in one filtering
+ * pass instead of cascading through an intermediate conversion.
  *
- * The halfband filter has these properties:
- * - Passband: 0 to ~0.45 * fs_in (cutoff below new Nyquist)
- * - Stopband: 0.5 * fs_in and above
- * - Every other coefficient is zero (efficient polyphase implementation)
+ * The anti-aliasing filter in both modes has these properties:
+ * - Passband: 0 to ~0.9 of the tighter Nyquist
+ * - Stopband: the new Nyquist and above
+ * - Polyphase decomposition: each output is one short contiguous dot
+ *   product against the input history, which vectorizes directly
  */
 class Resampler {
 public:
 	/**
-	 * Create resampler with default halfband filter
-	 * @param inputRate Input sample rate (e.g., 44100)
-	 * @param outputRate Output sample rate (e.g., 22050)
+	 * Create resampler for the given rate pair
+	 * @param inputRate Input sample rate (e.g., 44100, 48000)
+	 * @param outputRate Output sample rate (e.g., 44100, 22050); must not
+	 *                   exceed inputRate
 	 */
 	Resampler(int inputRate = 44100, int outputRate = 22050);
 
@@ -58,24 +65,46 @@ public:
 	 */
 	int getDelay() const;
 
+	/** Serialize streaming state (filter history, carried phase) */
+	void saveState(StateWriter& w) const;
+
+	/** Restore streaming state; the rate pair must match this instance */
+	bool loadState(StateReader& r);
+
 	// Sample rates
 	static constexpr int INPUT_RATE = 44100;
 	static constexpr int OUTPUT_RATE = 22050;
 	static constexpr int RATIO = 2;  // INPUT_RATE / OUTPUT_RATE
 
 private:
+	// Run the polyphase loop over a padded buffer (historySize_ context
+	// samples followed by inputSize new samples). t counts upsampled ticks
+	// relative to the first new input sample and is left >= inputSize * L
+	int runPolyphase(const float* padded, int inputSize, float* output,
+	                 int maxOutput, int64_t& t);
+
 	int inputRate_;
 	int outputRate_;
-	int ratio_;
+	int ratio_;       // Integer decimation factor (1 in rational mode)
 
-	// Halfband filter coefficients
+	// Rational mode: output runs at inputRate * L / M
+	int upFactor_ = 1;     // L (1 selects the integer path)
+	int downFactor_ = 1;   // M
+	int tapsPerPhase_ = 0;
+
+	// Anti-aliasing filter coefficients (prototype filter in rational mode)
 	std::vector<float> coefficients_;
 	int filterLength_;
 
+	// Per-phase coefficients, each phase reversed for contiguous dot
+	// products: phases_[p * tapsPerPhase_ + j] pairs with history sample j
+	std::vector<float> phases_;
+
 	// State for streaming mode
 	std::vector<float> history_;
 	std::vector<float> streamBuffer_;
 	int historySize_;
+	int64_t phaseAcc_ = 0;  // Carried upsampled-tick position (rational mode)
 };
 
 /**
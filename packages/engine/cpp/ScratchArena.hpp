@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Single upfront allocation that pipeline stages carve scratch from.
+ *
+ * reserve() once at construction, then take() hands out zeroed float spans
+ * until the reservation is exhausted. Spans never move and are never freed
+ * individually — the arena exists so the steady processing path does not
+ * touch the heap, and an exhausted take() asserts instead of reallocating.
+ */
+class ScratchArena {
+public:
+	void reserve(size_t floats) {
+		storage_.assign(floats, 0.0f);
+		used_ = 0;
+	}
+
+	float* take(size_t floats) {
+		assert(used_ + floats <= storage_.size() && "scratch arena exhausted");
+		float* span = storage_.data() + used_;
+		used_ += floats;
+		return span;
+	}
+
+	size_t size() const {
+		return storage_.size();
+	}
+
+	size_t used() const {
+		return used_;
+	}
+
+private:
+	std::vector<float> storage_;
+	size_t used_ = 0;
+};
+
+} // namespace engine
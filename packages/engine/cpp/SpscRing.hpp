@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Lock-free single-producer/single-consumer float ring
+ *
+ * Built for the audio-callback-to-processing-thread handoff: the capture
+ * callback memcpys samples in and never blocks, never allocates and never
+ * takes a lock; a processing thread drains at its leisure. Exactly one
+ * producer thread and one consumer thread - the indices are synchronized
+ * with acquire/release pairs only, which is sufficient for (and only for)
+ * that topology.
+ *
+ * Writes and reads are partial when the ring is full/empty: write() returns
+ * how many samples fit, so the producer can count overruns instead of
+ * silently dropping whole buffers.
+ */
+class SpscRing {
+public:
+	/** Capacity is rounded up to a power of two */
+	explicit SpscRing(size_t minCapacity) {
+		size_t cap = 1;
+		while (cap < minCapacity) {
+			cap <<= 1;
+		}
+		buffer_.assign(cap, 0.0f);
+		mask_ = cap - 1;
+	}
+
+	// Non-copyable
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	/**
+	 * Producer side: append up to numSamples
+	 * @return Samples actually written (less than numSamples when full)
+	 */
+	size_t write(const float* src, size_t numSamples) {
+		const size_t head = head_.load(std::memory_order_relaxed);
+		const size_t tail = tail_.load(std::memory_order_acquire);
+		const size_t n = std::min(numSamples, capacity() - (head - tail));
+		if (n == 0) {
+			return 0;
+		}
+
+		const size_t pos = head & mask_;
+		const size_t first = std::min(n, capacity() - pos);
+		std::memcpy(&buffer_[pos], src, first * sizeof(float));
+		std::memcpy(buffer_.data(), src + first, (n - first) * sizeof(float));
+
+		head_.store(head + n, std::memory_order_release);
+		return n;
+	}
+
+	/**
+	 * Consumer side: remove up to maxSamples
+	 * @return Samples actually read (0 when empty)
+	 */
+	size_t read(float* dst, size_t maxSamples) {
+		const size_t tail = tail_.load(std::memory_order_relaxed);
+		const size_t head = head_.load(std::memory_order_acquire);
+		const size_t n = std::min(maxSamples, head - tail);
+		if (n == 0) {
+			return 0;
+		}
+
+		const size_t pos = tail & mask_;
+		const size_t first = std::min(n, capacity() - pos);
+		std::memcpy(dst, &buffer_[pos], first * sizeof(float));
+		std::memcpy(dst + first, buffer_.data(), (n - first) * sizeof(float));
+
+		tail_.store(tail + n, std::memory_order_release);
+		return n;
+	}
+
+	/** Samples currently buffered (approximate from either thread) */
+	size_t size() const {
+		return head_.load(std::memory_order_acquire) -
+		       tail_.load(std::memory_order_acquire);
+	}
+
+	size_t capacity() const {
+		return mask_ + 1;
+	}
+
+private:
+	std::vector<float> buffer_;
+	size_t mask_ = 0;
+
+	// Indices grow monotonically and are masked on access; keeping them on
+	// separate cache lines avoids producer/consumer false sharing
+	alignas(64) std::atomic<size_t> head_{0};  // Producer-owned
+	alignas(64) std::atomic<size_t> tail_{0};  // Consumer-owned
+};
+
+} // namespace engine
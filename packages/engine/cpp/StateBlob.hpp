@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Byte-stream helpers for the Engine state snapshot blob.
+ *
+ * Values are streamed as raw host-order bytes: a snapshot is written and
+ * restored by the same build on the same device, so no cross-platform
+ * encoding is attempted. Every structural quantity (ring capacities,
+ * buffer sizes, rates) is written alongside the data and re-checked on
+ * load, so a blob from a different build configuration fails cleanly.
+ */
+class StateWriter {
+public:
+	explicit StateWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+	void writeBytes(const void* src, size_t n) {
+		const uint8_t* p = static_cast<const uint8_t*>(src);
+		out_.insert(out_.end(), p, p + n);
+	}
+
+	template <typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value,
+		              "StateWriter only streams trivially copyable values");
+		writeBytes(&value, sizeof(T));
+	}
+
+	void writeFloats(const float* src, size_t n) {
+		writeBytes(src, n * sizeof(float));
+	}
+
+	void writeString(const std::string& s) {
+		write(static_cast<uint32_t>(s.size()));
+		writeBytes(s.data(), s.size());
+	}
+
+private:
+	std::vector<uint8_t>& out_;
+};
+
+/**
+ * Bounds-checked reader over a snapshot blob. Any short read or failed
+ * expectation latches ok() false; callers can chain reads and check once.
+ */
+class StateReader {
+public:
+	StateReader(const uint8_t* data, size_t size)
+		: p_(data), end_(data + size) {}
+
+	bool ok() const { return ok_; }
+
+	/** True when the whole blob was consumed without errors */
+	bool atEnd() const { return ok_ && p_ == end_; }
+
+	bool readBytes(void* dst, size_t n) {
+		if (!ok_ || static_cast<size_t>(end_ - p_) < n) {
+			ok_ = false;
+			return false;
+		}
+		std::memcpy(dst, p_, n);
+		p_ += n;
+		return true;
+	}
+
+	template <typename T>
+	bool read(T& value) {
+		static_assert(std::is_trivially_copyable<T>::value,
+		              "StateReader only streams trivially copyable values");
+		return readBytes(&value, sizeof(T));
+	}
+
+	/** Read a value and require it to equal this build's expected one */
+	template <typename T>
+	bool expect(const T& expected) {
+		T value{};
+		if (!read(value)) {
+			return false;
+		}
+		if (!(value == expected)) {
+			ok_ = false;
+		}
+		return ok_;
+	}
+
+	bool readFloats(float* dst, size_t n) {
+		return readBytes(dst, n * sizeof(float));
+	}
+
+	bool readString(std::string& s) {
+		uint32_t len = 0;
+		if (!read(len)) {
+			return false;
+		}
+		if (static_cast<size_t>(end_ - p_) < len) {
+			ok_ = false;
+			return false;
+		}
+		s.assign(reinterpret_cast<const char*>(p_), len);
+		p_ += len;
+		return true;
+	}
+
+private:
+	const uint8_t* p_;
+	const uint8_t* end_;
+	bool ok_ = true;
+};
+
+} // namespace engine
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Engine.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Work-stealing analysis pool for library-scale batch scanning
+ *
+ * Runs one Engine per worker thread (engines are non-copyable and stateful,
+ * so they cannot be shared) over a work-stealing queue of file jobs. Each
+ * worker pops from the back of its own deque and steals from the front of a
+ * neighbour's when idle, so a handful of long tracks cannot starve the other
+ * cores near the end of a scan. The ONNX environment behind every engine's
+ * sessions is already shared process-wide via OnnxRuntime::instance().
+ *
+ * Decoding is injected: the pool knows nothing about codecs, it just hands
+ * each worker's decode function a path and expects 44.1kHz mono floats back.
+ * Completion callbacks fire on worker threads; the callback must be
+ * thread-safe.
+ */
+class TrackAnalysisPool {
+public:
+	/** Decode a file to 44.1kHz mono floats; false skips the track */
+	using Decode = std::function<bool(const std::string& path, std::vector<float>& samples)>;
+
+	/** Per-track completion callback (runs on a worker thread) */
+	using Done = std::function<void(const std::string& path,
+	                                const Engine::AnalysisResult& result)>;
+
+	/**
+	 * Start the pool
+	 * @param numWorkers Worker thread count (0 uses hardware_concurrency)
+	 * @param beatnetPath Path to beatnet.onnx ("" skips BPM detection)
+	 * @param keynetPath Path to keynet.onnx ("" skips key detection)
+	 * @param decode Decode function shared by all workers
+	 * @param done Completion callback shared by all workers
+	 */
+	TrackAnalysisPool(size_t numWorkers,
+	                  const std::string& beatnetPath,
+	                  const std::string& keynetPath,
+	                  Decode decode, Done done)
+		: decode_(std::move(decode)), done_(std::move(done)) {
+		if (numWorkers == 0) {
+			numWorkers = std::thread::hardware_concurrency();
+			if (numWorkers == 0) {
+				numWorkers = 1;
+			}
+		}
+
+		workers_.reserve(numWorkers);
+		for (size_t w = 0; w < numWorkers; w++) {
+			auto worker = std::make_unique<Worker>();
+			worker->engine = std::make_unique<Engine>();
+			if (!beatnetPath.empty()) {
+				worker->engine->loadModel(beatnetPath);
+			}
+			if (!keynetPath.empty()) {
+				worker->engine->loadKeyModel(keynetPath);
+			}
+			workers_.push_back(std::move(worker));
+		}
+		for (size_t w = 0; w < numWorkers; w++) {
+			workers_[w]->thread = std::thread(&TrackAnalysisPool::workerLoop, this, w);
+		}
+	}
+
+	~TrackAnalysisPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		workCv_.notify_all();
+		for (auto& worker : workers_) {
+			if (worker->thread.joinable()) {
+				worker->thread.join();
+			}
+		}
+	}
+
+	// Non-copyable
+	TrackAnalysisPool(const TrackAnalysisPool&) = delete;
+	TrackAnalysisPool& operator=(const TrackAnalysisPool&) = delete;
+
+	/** Queue a track for analysis (round-robins across worker deques) */
+	void submit(const std::string& path) {
+		Worker& worker = *workers_[nextWorker_ % workers_.size()];
+		nextWorker_++;
+		// The push happens under mutex_ - the mutex the workCv_ wait uses -
+		// so a worker can never evaluate the wait predicate between the push
+		// and the notify and sleep through both. pending_ still increments
+		// before the job is visible, so a fast worker cannot decrement it
+		// below zero.
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pending_++;
+			std::lock_guard<std::mutex> jobLock(worker.mutex);
+			worker.jobs.push_back(path);
+		}
+		workCv_.notify_one();
+	}
+
+	/** Block until every submitted track has completed */
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		idleCv_.wait(lock, [this] { return pending_ == 0; });
+	}
+
+	/** Number of worker threads (and Engine instances) */
+	size_t workerCount() const {
+		return workers_.size();
+	}
+
+private:
+	struct Worker {
+		std::unique_ptr<Engine> engine;
+		std::thread thread;
+		std::mutex mutex;
+		std::deque<std::string> jobs;
+	};
+
+	// Own queue from the back (most recently submitted), steals from the
+	// front so thieves and owner contend on opposite ends
+	bool take(size_t self, std::string& path) {
+		{
+			Worker& own = *workers_[self];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.jobs.empty()) {
+				path = std::move(own.jobs.back());
+				own.jobs.pop_back();
+				return true;
+			}
+		}
+		for (size_t i = 1; i < workers_.size(); i++) {
+			Worker& victim = *workers_[(self + i) % workers_.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.jobs.empty()) {
+				path = std::move(victim.jobs.front());
+				victim.jobs.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Any job queued on any worker? Called from the cv predicate while
+	// mutex_ is held; submit() publishes jobs under the same mutex, so a
+	// job can never appear between a false predicate and the atomic block
+	// (lock order is always mutex_ then worker.mutex)
+	bool anyQueued() {
+		for (auto& worker : workers_) {
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			if (!worker->jobs.empty()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void workerLoop(size_t self) {
+		std::vector<float> samples;
+		for (;;) {
+			std::string path;
+			if (!take(self, path)) {
+				std::unique_lock<std::mutex> lock(mutex_);
+				workCv_.wait(lock, [this] { return stop_ || anyQueued(); });
+				if (stop_) {
+					return;
+				}
+				continue;
+			}
+
+			samples.clear();
+			Engine::AnalysisResult result;
+			result.bpm = 0.0f;
+			result.key = {"", "", 0.0f, false};
+			if (decode_(path, samples)) {
+				result = workers_[self]->engine->analyzeBuffer(
+					samples.data(), samples.size());
+			}
+			if (done_) {
+				done_(path, result);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				pending_--;
+				if (pending_ == 0) {
+					idleCv_.notify_all();
+				}
+			}
+		}
+	}
+
+	Decode decode_;
+	Done done_;
+	std::vector<std::unique_ptr<Worker>> workers_;
+	size_t nextWorker_ = 0;
+
+	std::mutex mutex_;                 // Guards pending_ and stop_
+	std::condition_variable workCv_;   // Signaled on submit and stop
+	std::condition_variable idleCv_;   // Signaled when pending_ hits zero
+	size_t pending_ = 0;
+	bool stop_ = false;
+};
+
+} // namespace engine
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * Batched vectorized math kernels for spectral scaling
+ *
+ * Both feature extractors end every frame with an elementwise transcendental
+ * pass (log1p for the CQT, log10(1 + x) for the mel bands) plus magnitude
+ * square roots. Calling scalar libm per element serializes those loops; these
+ * helpers process whole arrays instead.
+ *
+ * On Apple platforms they dispatch to vForce/vDSP (Accelerate is already
+ * linked for the CQT kernels). Elsewhere they use a branch-light polynomial
+ * log1p (cephes-derived, accurate to ~1 ulp over the magnitudes we feed it)
+ * written so the compiler auto-vectorizes the loop under NEON or AVX.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__APPLE__)
+#include <Accelerate/Accelerate.h>
+#endif
+
+namespace engine {
+namespace vecmath {
+
+namespace detail {
+
+/**
+ * Polynomial log(1 + x) for x >= 0 (cephes logf core)
+ *
+ * Forms y = 1 + x, splits y into exponent and mantissa in [sqrt(0.5),
+ * sqrt(2)) via bit manipulation, and evaluates a degree-9 minimax polynomial.
+ * The rounding error lost when forming 1 + x is recovered with a first-order
+ * correction (err / y), which keeps full float precision near zero.
+ */
+inline float log1pCore(float x) {
+	const float y = 1.0f + x;
+	const float err = x - (y - 1.0f);
+
+	std::uint32_t bits;
+	std::memcpy(&bits, &y, sizeof(bits));
+	int e = static_cast<int>((bits >> 23) & 0xffu) - 126;
+	bits = (bits & 0x007fffffu) | 0x3f000000u;
+	float m;
+	std::memcpy(&m, &bits, sizeof(m));
+
+	if (m < 0.70710678f) {
+		m += m;
+		e -= 1;
+	}
+	m -= 1.0f;
+
+	const float z = m * m;
+	float p = 7.0376836292e-2f;
+	p = p * m - 1.1514610310e-1f;
+	p = p * m + 1.1676998740e-1f;
+	p = p * m - 1.2420140846e-1f;
+	p = p * m + 1.4249322787e-1f;
+	p = p * m - 1.6668057665e-1f;
+	p = p * m + 2.0000714765e-1f;
+	p = p * m - 2.4999993993e-1f;
+	p = p * m + 3.3333331174e-1f;
+
+	float r = m * z * p;
+	r -= 0.5f * z;
+	r += static_cast<float>(e) * -2.12194440e-4f;
+	r += m;
+	r += static_cast<float>(e) * 0.693359375f;
+	return r + err / y;
+}
+
+} // namespace detail
+
+/** out[i] = log(1 + in[i]) */
+inline void log1p(const float* in, float* out, int n) {
+#if defined(__APPLE__)
+	vvlog1pf(out, in, &n);
+#else
+	for (int i = 0; i < n; i++) {
+		out[i] = detail::log1pCore(in[i]);
+	}
+#endif
+}
+
+/** out[i] = log10(1 + in[i]) */
+inline void log10p1(const float* in, float* out, int n) {
+#if defined(__APPLE__)
+	vvlog1pf(out, in, &n);
+	const float log10e = 0.4342944819f;
+	vDSP_vsmul(out, 1, &log10e, out, 1, static_cast<vDSP_Length>(n));
+#else
+	for (int i = 0; i < n; i++) {
+		out[i] = detail::log1pCore(in[i]) * 0.4342944819f;
+	}
+#endif
+}
+
+/** out[i] = sqrt(in[i]) */
+inline void sqrt(const float* in, float* out, int n) {
+#if defined(__APPLE__)
+	vvsqrtf(out, in, &n);
+#else
+	// std::sqrt lowers to the hardware instruction; the loop vectorizes
+	for (int i = 0; i < n; i++) {
+		out[i] = std::sqrt(in[i]);
+	}
+#endif
+}
+
+} // namespace vecmath
+} // namespace engine
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine {
+
+/**
+ * Memory-mapped WAV reader for canonical PCM files
+ *
+ * Maps the whole file read-only and parses the RIFF chunk list in place, so
+ * repeated runs over a large corpus hit the page cache instead of re-reading
+ * and re-copying sample data. Supports mono 16/32-bit PCM and 32-bit float.
+ *
+ * For float files the sample region is exposed directly as a zero-copy span
+ * via samples(); integer formats are converted lazily per chunk through
+ * read() into a caller-provided buffer. No resampling - callers needing a
+ * different rate still go through a decoder.
+ */
+class WavReader {
+public:
+	WavReader() = default;
+
+	~WavReader() {
+		close();
+	}
+
+	// Non-copyable (owns the mapping)
+	WavReader(const WavReader&) = delete;
+	WavReader& operator=(const WavReader&) = delete;
+
+	/**
+	 * Map and parse a WAV file
+	 * @return true if the file is a supported mono PCM/float WAV
+	 */
+	bool open(const std::string& path) {
+		close();
+
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+		struct stat st = {};
+		if (fstat(fd, &st) != 0 || st.st_size < 44) {
+			::close(fd);
+			return false;
+		}
+		size_ = static_cast<size_t>(st.st_size);
+		void* map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (map == MAP_FAILED) {
+			size_ = 0;
+			return false;
+		}
+		map_ = static_cast<const uint8_t*>(map);
+
+		if (!parse()) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	/** Unmap the file (also called by the destructor) */
+	void close() {
+		if (map_) {
+			munmap(const_cast<uint8_t*>(map_), size_);
+		}
+		map_ = nullptr;
+		size_ = 0;
+		dataOffset_ = 0;
+		dataBytes_ = 0;
+		sampleRate_ = 0;
+		bitsPerSample_ = 0;
+		format_ = 0;
+	}
+
+	bool isOpen() const { return map_ != nullptr; }
+
+	int sampleRate() const { return sampleRate_; }
+
+	int bitsPerSample() const { return bitsPerSample_; }
+
+	/** Total mono sample frames in the file */
+	size_t frameCount() const {
+		return bitsPerSample_ ? dataBytes_ / (bitsPerSample_ / 8) : 0;
+	}
+
+	/** True when the on-disk format is 32-bit IEEE float */
+	bool isFloat() const { return format_ == FORMAT_FLOAT; }
+
+	/**
+	 * Zero-copy span over the sample region
+	 *
+	 * Only available for float files whose data chunk lands on a 4-byte
+	 * boundary (canonical headers do); otherwise nullptr - use read().
+	 */
+	const float* samples() const {
+		if (!isFloat() || (dataOffset_ & 3) != 0) {
+			return nullptr;
+		}
+		return reinterpret_cast<const float*>(map_ + dataOffset_);
+	}
+
+	/**
+	 * Read mono float frames starting at the given frame offset
+	 *
+	 * Integer samples are converted on the fly; float samples are copied.
+	 * @return Number of frames written (0 at end of file)
+	 */
+	size_t read(size_t offset, float* out, size_t maxFrames) const {
+		const size_t total = frameCount();
+		if (offset >= total) {
+			return 0;
+		}
+		const size_t frames = std::min(maxFrames, total - offset);
+
+		if (format_ == FORMAT_FLOAT) {
+			std::memcpy(out, map_ + dataOffset_ + offset * 4, frames * 4);
+			return frames;
+		}
+		if (bitsPerSample_ == 16) {
+			const uint8_t* src = map_ + dataOffset_ + offset * 2;
+			for (size_t i = 0; i < frames; i++) {
+				int16_t s;
+				std::memcpy(&s, src + i * 2, 2);
+				out[i] = static_cast<float>(s) * (1.0f / 32768.0f);
+			}
+			return frames;
+		}
+		// 32-bit PCM
+		const uint8_t* src = map_ + dataOffset_ + offset * 4;
+		for (size_t i = 0; i < frames; i++) {
+			int32_t s;
+			std::memcpy(&s, src + i * 4, 4);
+			out[i] = static_cast<float>(s) * (1.0f / 2147483648.0f);
+		}
+		return frames;
+	}
+
+private:
+	static constexpr uint16_t FORMAT_PCM = 1;
+	static constexpr uint16_t FORMAT_FLOAT = 3;
+
+	uint32_t readU32(size_t offset) const {
+		uint32_t v;
+		std::memcpy(&v, map_ + offset, 4);
+		return v;
+	}
+
+	uint16_t readU16(size_t offset) const {
+		uint16_t v;
+		std::memcpy(&v, map_ + offset, 2);
+		return v;
+	}
+
+	// Walk the RIFF chunk list for "fmt " and "data", skipping everything
+	// else (LIST/INFO metadata is common in encoder output)
+	bool parse() {
+		if (std::memcmp(map_, "RIFF", 4) != 0 || std::memcmp(map_ + 8, "WAVE", 4) != 0) {
+			return false;
+		}
+
+		uint16_t channels = 0;
+		size_t pos = 12;
+		while (pos + 8 <= size_) {
+			const uint32_t chunkSize = readU32(pos + 4);
+			const size_t body = pos + 8;
+			if (body + chunkSize > size_) {
+				return false;
+			}
+
+			if (std::memcmp(map_ + pos, "fmt ", 4) == 0 && chunkSize >= 16) {
+				format_ = readU16(body);
+				channels = readU16(body + 2);
+				sampleRate_ = static_cast<int>(readU32(body + 4));
+				bitsPerSample_ = readU16(body + 14);
+			} else if (std::memcmp(map_ + pos, "data", 4) == 0) {
+				dataOffset_ = body;
+				dataBytes_ = chunkSize;
+			}
+
+			// Chunks are word-aligned
+			pos = body + chunkSize + (chunkSize & 1);
+		}
+
+		if (dataBytes_ == 0 || channels != 1 || sampleRate_ <= 0) {
+			return false;
+		}
+		if (format_ == FORMAT_PCM) {
+			return bitsPerSample_ == 16 || bitsPerSample_ == 32;
+		}
+		return format_ == FORMAT_FLOAT && bitsPerSample_ == 32;
+	}
+
+	const uint8_t* map_ = nullptr;
+	size_t size_ = 0;
+	size_t dataOffset_ = 0;
+	size_t dataBytes_ = 0;
+	int sampleRate_ = 0;
+	uint16_t bitsPerSample_ = 0;
+	uint16_t format_ = 0;
+};
+
+} // namespace engine
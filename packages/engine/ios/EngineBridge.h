@@ -136,3 +136,50 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 NS_ASSUME_NONNULL_END
+
+// =============================================================================
+// C-linkage fast path for the AVAudioEngine tap
+//
+// The tap thread hands its float pointer straight to EngineFastPathPush,
+// which copies into a lock-free ring; a bridge-owned processing thread
+// drains the ring into the engine. No ObjC message dispatch, autorelease
+// or retain/release happens per buffer on the tap side.
+// =============================================================================
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start the fast path processing thread (idempotent)
+ * @return YES once the thread is running
+ */
+BOOL EngineFastPathStart(void);
+
+/**
+ * Stop the processing thread and discard buffered audio
+ */
+void EngineFastPathStop(void);
+
+/**
+ * Push samples from the tap/render thread. Wait-free; when the ring is
+ * full the excess is dropped and counted as an overrun.
+ * @return Number of samples accepted
+ */
+size_t EngineFastPathPush(const float * _Nonnull samples, size_t count);
+
+/**
+ * Read the latest activations produced by the processing thread
+ * @return YES if any frame result has been produced since start
+ */
+BOOL EngineFastPathActivations(float * _Nullable beatActivation,
+                               float * _Nullable downbeatActivation);
+
+/**
+ * Number of pushes that could not be fully buffered since start
+ */
+uint64_t EngineFastPathOverruns(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,10 @@
 #import "EngineBridge.h"
 #include "Engine.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <stdexcept>
 #include <mutex>
@@ -380,6 +385,108 @@
 	}
 }
 
+// =============================================================================
+// C-linkage fast path
+// =============================================================================
+
+namespace {
+
+constexpr size_t FAST_RING_CAPACITY = 44100 * 2;  // 2 seconds at 44100 Hz
+constexpr size_t FAST_CHUNK = 4096;
+
+std::unique_ptr<engine::SpscRing> fastRing;
+std::thread fastThread;
+std::atomic<bool> fastRunning{false};
+std::atomic<bool> fastHasState{false};
+std::atomic<float> fastBeat{0.0f};
+std::atomic<float> fastDown{0.0f};
+std::atomic<uint64_t> fastOverruns{0};
+
+void fastPathLoop() {
+	float chunk[FAST_CHUNK];
+	float beat = 0.0f;
+	float down = 0.0f;
+
+	while (fastRunning.load(std::memory_order_acquire)) {
+		const size_t got = fastRing->read(chunk, FAST_CHUNK);
+		if (got == 0) {
+			// ~20ms buffers arrive at 50/s; a short sleep keeps latency
+			// low without spinning
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			continue;
+		}
+
+		if ([[EngineBridge shared] processAudioBuffer:chunk
+		                                  sampleCount:got
+		                               beatActivation:&beat
+		                           downbeatActivation:&down]) {
+			fastBeat.store(beat, std::memory_order_relaxed);
+			fastDown.store(down, std::memory_order_relaxed);
+			fastHasState.store(true, std::memory_order_release);
+		}
+	}
+}
+
+} // namespace
+
+extern "C" BOOL EngineFastPathStart(void) {
+	if (fastRunning.load(std::memory_order_acquire)) {
+		return YES;
+	}
+	if (!fastRing) {
+		fastRing = std::make_unique<engine::SpscRing>(FAST_RING_CAPACITY);
+	}
+	// Drop audio left over from a previous run
+	float scratch[FAST_CHUNK];
+	while (fastRing->read(scratch, FAST_CHUNK) > 0) {
+	}
+	fastHasState.store(false, std::memory_order_relaxed);
+	fastOverruns.store(0, std::memory_order_relaxed);
+	fastRunning.store(true, std::memory_order_release);
+	fastThread = std::thread(fastPathLoop);
+	return YES;
+}
+
+extern "C" void EngineFastPathStop(void) {
+	if (!fastRunning.exchange(false, std::memory_order_acq_rel)) {
+		return;
+	}
+	if (fastThread.joinable()) {
+		fastThread.join();
+	}
+	// The ring stays allocated (a racing push must never see a dead
+	// pointer); leftover audio is dropped on the next start
+}
+
+extern "C" size_t EngineFastPathPush(const float *samples, size_t count) {
+	if (!fastRunning.load(std::memory_order_acquire)) {
+		return 0;
+	}
+	const size_t written = fastRing->write(samples, count);
+	if (written < count) {
+		fastOverruns.fetch_add(1, std::memory_order_relaxed);
+	}
+	return written;
+}
+
+extern "C" BOOL EngineFastPathActivations(float *beatActivation,
+                                          float *downbeatActivation) {
+	if (!fastHasState.load(std::memory_order_acquire)) {
+		return NO;
+	}
+	if (beatActivation != nullptr) {
+		*beatActivation = fastBeat.load(std::memory_order_relaxed);
+	}
+	if (downbeatActivation != nullptr) {
+		*downbeatActivation = fastDown.load(std::memory_order_relaxed);
+	}
+	return YES;
+}
+
+extern "C" uint64_t EngineFastPathOverruns(void) {
+	return fastOverruns.load(std::memory_order_relaxed);
+}
+
 // =============================================================================
 // Class Properties (Constants)
 // Note: These are hardcoded to avoid C++ static initialization issues in release builds
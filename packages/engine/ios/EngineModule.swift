@@ -7,6 +7,8 @@ public class EngineModule: Module {
 	private var audioEngine: AVAudioEngine?
 	private var isRecordingAudio = false
 	private var enableWaveformEvents = false
+	private var usingFastPath = false
+	private var stateTimer: DispatchSourceTimer?
 
 	private let waveformBufferSize = 128
 	private let waveformInputSize = 256
@@ -253,12 +255,24 @@ public class EngineModule: Module {
 		lastStateEmitTime = 0
 		lastWaveformEmitTime = 0
 
+		// Fast path: the tap hands its float pointer straight to the bridge's
+		// lock-free ring and a polling timer emits events, so no ObjC
+		// dispatch or autorelease happens per buffer on the tap thread
+		usingFastPath = EngineFastPathStart()
+		if usingFastPath {
+			let timer = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "engine.events"))
+			timer.schedule(deadline: .now() + stateEmitInterval, repeating: stateEmitInterval)
+			timer.setEventHandler { [weak self] in self?.pollFastPath() }
+			timer.resume()
+			stateTimer = timer
+		}
+
 		inputNode.installTap(onBus: 0, bufferSize: bufferSize, format: inputFormat) { [weak self] buffer, _ in
 			guard let self = self else { return }
 
 			if inputFormat.sampleRate == 44100 {
 				guard let data = buffer.floatChannelData?[0] else { return }
-				self.processAudioSamples(data, count: Int(buffer.frameLength))
+				self.ingest(data, count: Int(buffer.frameLength))
 				return
 			}
 			guard let converter = converter, let conversionBuffer = conversionBuffer else {
@@ -269,7 +283,7 @@ public class EngineModule: Module {
 				return
 			}
 			guard let data = conversionBuffer.floatChannelData?[0] else { return }
-			self.processAudioSamples(data, count: sampleCount)
+			self.ingest(data, count: sampleCount)
 		}
 
 		audioEngine.prepare()
@@ -282,6 +296,10 @@ public class EngineModule: Module {
 		audioEngine?.inputNode.removeTap(onBus: 0)
 		audioEngine?.stop()
 		audioEngine = nil
+		stateTimer?.cancel()
+		stateTimer = nil
+		EngineFastPathStop()
+		usingFastPath = false
 		isRecordingAudio = false
 		lastStateEmitTime = 0
 		lastWaveformEmitTime = 0
@@ -370,6 +388,39 @@ public class EngineModule: Module {
 	private var processCallCount = 0
 	private var recordingStartTime: TimeInterval = 0
 
+	/// Tap-side ingestion. On the fast path the samples go straight into the
+	/// bridge's lock-free ring and events come from the polling timer; the
+	/// legacy path processes synchronously on the tap thread.
+	private func ingest(_ samples: UnsafePointer<Float>, count: Int) {
+		guard count > 0 else { return }
+		if usingFastPath {
+			_ = EngineFastPathPush(samples, count)
+			if enableWaveformEvents {
+				accumulateWaveform(samples, count: count)
+			}
+			return
+		}
+		processAudioSamples(samples, count: count)
+	}
+
+	/// Timer-driven event emission for the fast path (runs at stateEmitInterval)
+	private func pollFastPath() {
+		var beatActivation: Float = 0
+		var downbeatActivation: Float = 0
+		let now = Date().timeIntervalSince1970
+		let timestamp = now - recordingStartTime
+
+		if EngineFastPathActivations(&beatActivation, &downbeatActivation) {
+			lastStateEmitTime = now
+			sendEvent("onState", [
+				"beatActivation": Double(beatActivation),
+				"downbeatActivation": Double(downbeatActivation),
+				"timestamp": timestamp
+			])
+		}
+		emitKeyIfChanged(timestamp)
+	}
+
 	private func processAudioSamples(_ samples: UnsafePointer<Float>, count: Int) {
 		processCallCount += 1
 		guard count > 0 else { return }
@@ -396,7 +447,16 @@ public class EngineModule: Module {
 			])
 		}
 
-		// Check for key detection updates (emit on key change OR significant confidence change)
+		emitKeyIfChanged(timestamp)
+
+		// Waveform processing
+		if enableWaveformEvents {
+			accumulateWaveform(samples, count: count)
+		}
+	}
+
+	/// Emit onKey when the key or its confidence changed meaningfully
+	private func emitKeyIfChanged(_ timestamp: TimeInterval) {
 		let keyResult = bridge.getKey()
 		let confidenceChanged = abs(keyResult.confidence - lastKeyConfidence) > 0.01
 		let keyChanged = keyResult.notation != lastKeyNotation || keyResult.camelot != lastKeyCamelot
@@ -412,65 +472,66 @@ public class EngineModule: Module {
 				"timestamp": timestamp
 			])
 		}
+	}
 
-		// Waveform processing
-		if enableWaveformEvents {
-			for i in 0..<count {
-				let sample = samples[i]
-				waveformInputBuffer[waveformWriteIndex] = sample
-				waveformWriteIndex = (waveformWriteIndex + 1) % waveformInputSize
-				waveformSamplesAccumulated += 1
-			}
+	/// Accumulate samples into the waveform ring and emit onWaveform (tap thread)
+	private func accumulateWaveform(_ samples: UnsafePointer<Float>, count: Int) {
+		let now = Date().timeIntervalSince1970
+		for i in 0..<count {
+			let sample = samples[i]
+			waveformInputBuffer[waveformWriteIndex] = sample
+			waveformWriteIndex = (waveformWriteIndex + 1) % waveformInputSize
+			waveformSamplesAccumulated += 1
+		}
 
-			// Emit waveform more frequently at 44100 Hz (adjust threshold)
-			let waveformThreshold = waveformInputSize * 2  // Account for higher sample rate
-			if waveformSamplesAccumulated >= waveformThreshold {
-				waveformSamplesAccumulated = 0
-				if now - lastWaveformEmitTime < waveformEmitInterval {
-					return
-				}
-				lastWaveformEmitTime = now
-
-				var peak: Float = 0
-				var sumSquares: Float = 0
-				let samplesPerPoint = waveformInputSize / waveformBufferSize
-				var downsampledPoints = [Double](repeating: 0, count: waveformBufferSize)
-
-				for i in 0..<waveformBufferSize {
-					var sum: Float = 0
-					for j in 0..<samplesPerPoint {
-						let readIndex = (waveformWriteIndex + i * samplesPerPoint + j) % waveformInputSize
-						let sample = waveformInputBuffer[readIndex]
-						sum += sample
-						let absVal = abs(sample)
-						if absVal > peak { peak = absVal }
-						sumSquares += sample * sample
-					}
-					downsampledPoints[i] = Double(sum / Float(samplesPerPoint))
+		// Emit waveform more frequently at 44100 Hz (adjust threshold)
+		let waveformThreshold = waveformInputSize * 2  // Account for higher sample rate
+		if waveformSamplesAccumulated >= waveformThreshold {
+			waveformSamplesAccumulated = 0
+			if now - lastWaveformEmitTime < waveformEmitInterval {
+				return
+			}
+			lastWaveformEmitTime = now
+
+			var peak: Float = 0
+			var sumSquares: Float = 0
+			let samplesPerPoint = waveformInputSize / waveformBufferSize
+			var downsampledPoints = [Double](repeating: 0, count: waveformBufferSize)
+
+			for i in 0..<waveformBufferSize {
+				var sum: Float = 0
+				for j in 0..<samplesPerPoint {
+					let readIndex = (waveformWriteIndex + i * samplesPerPoint + j) % waveformInputSize
+					let sample = waveformInputBuffer[readIndex]
+					sum += sample
+					let absVal = abs(sample)
+					if absVal > peak { peak = absVal }
+					sumSquares += sample * sample
 				}
+				downsampledPoints[i] = Double(sum / Float(samplesPerPoint))
+			}
 
-				let rms = sqrt(sumSquares / Float(waveformInputSize))
+			let rms = sqrt(sumSquares / Float(waveformInputSize))
 
-				var orderedSamples = [Float](repeating: 0, count: waveformInputSize)
-				for i in 0..<waveformInputSize {
-					let readIndex = (waveformWriteIndex + i) % waveformInputSize
-					orderedSamples[i] = waveformInputBuffer[readIndex]
-				}
-				let bands = computeFrequencyBands(orderedSamples)
+			var orderedSamples = [Float](repeating: 0, count: waveformInputSize)
+			for i in 0..<waveformInputSize {
+				let readIndex = (waveformWriteIndex + i) % waveformInputSize
+				orderedSamples[i] = waveformInputBuffer[readIndex]
+			}
+			let bands = computeFrequencyBands(orderedSamples)
 
-				waveformEmitCount += 1
-				if waveformEmitCount == 1 {
-					debugLog("First waveform emit - peak: \(peak), rms: \(rms), bands: \(bands)")
-				}
-				sendEvent("onWaveform", [
-					"samples": downsampledPoints,
-					"peak": Double(peak),
-					"rms": Double(rms),
-					"low": Double(bands.low),
-					"mid": Double(bands.mid),
-					"high": Double(bands.high)
-				])
+			waveformEmitCount += 1
+			if waveformEmitCount == 1 {
+				debugLog("First waveform emit - peak: \(peak), rms: \(rms), bands: \(bands)")
 			}
+			sendEvent("onWaveform", [
+				"samples": downsampledPoints,
+				"peak": Double(peak),
+				"rms": Double(rms),
+				"low": Double(bands.low),
+				"mid": Double(bands.mid),
+				"high": Double(bands.high)
+			])
 		}
 	}
 }
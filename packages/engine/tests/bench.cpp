@@ -0,0 +1,196 @@
+/**
+ * Per-stage DSP microbenchmarks
+ *
+ * Times each pipeline stage in isolation with fixed seeded inputs and
+ * reports ns/op, ops/sec and the realtime multiple (how many seconds of
+ * audio the stage processes per wall-clock second). Medians over repeated
+ * batches keep the numbers stable against scheduler noise.
+ *
+ * Build: cmake --build <dir> --target engine_bench && ./engine_bench
+ * Configure with -DCMAKE_BUILD_TYPE=Release - the timed code lives in
+ * engine_testable, so an unoptimized build benchmarks the wrong thing.
+ */
+
+#include "AutocorrBpm.hpp"
+#include "CqtExtractor.hpp"
+#include "MelExtractor.hpp"
+#include "Resampler.hpp"
+#ifdef ONNX_ENABLED
+#include "OnnxModel.hpp"
+#endif
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+// Keep results observable so the optimizer cannot drop the benched calls
+volatile float g_sink = 0.0f;
+
+/**
+ * Run fn in batches and report the median per-op time
+ * @param itemSeconds Seconds of audio one op represents (for the realtime
+ *                    multiple); 0 hides that column
+ */
+template <typename Fn>
+void bench(const char* name, double itemSeconds, Fn&& fn) {
+	constexpr int WARMUP = 3;
+	constexpr int BATCHES = 15;
+
+	// Size batches so each one runs long enough to time reliably
+	for (int i = 0; i < WARMUP; i++) {
+		fn();
+	}
+	const auto probeStart = std::chrono::steady_clock::now();
+	fn();
+	const double probeNs = static_cast<double>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - probeStart).count());
+	const int opsPerBatch = std::max(1, static_cast<int>(2e6 / std::max(probeNs, 1.0)));
+
+	std::vector<double> samples(BATCHES);
+	for (int b = 0; b < BATCHES; b++) {
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < opsPerBatch; i++) {
+			fn();
+		}
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - start).count();
+		samples[b] = static_cast<double>(ns) / opsPerBatch;
+	}
+	std::sort(samples.begin(), samples.end());
+	const double nsPerOp = samples[BATCHES / 2];
+	const double opsPerSec = 1e9 / nsPerOp;
+
+	if (itemSeconds > 0.0) {
+		printf("%-32s %12.0f ns/op %12.0f ops/s %10.1fx realtime\n",
+		       name, nsPerOp, opsPerSec, opsPerSec * itemSeconds);
+	} else {
+		printf("%-32s %12.0f ns/op %12.0f ops/s\n", name, nsPerOp, opsPerSec);
+	}
+}
+
+} // namespace
+
+int main() {
+	printf("Engine DSP microbenchmarks (median of 15 batches, seeded inputs)\n");
+	printf("================================================================================\n");
+
+	// ------------------------------------------------------------------------
+	// LogFilterbank::apply - one op = one 20ms frame at 22050Hz
+	// ------------------------------------------------------------------------
+	{
+		LogFilterbank filterbank(MelConfig::FFT_SIZE, MelConfig::SAMPLE_RATE,
+		                         24, 30.0f, 17000.0f);
+		auto magnitude = test_utils::generateNoise(filterbank.getNumBins(), 1.0f, 42);
+		for (auto& m : magnitude) {
+			m = std::fabs(m);
+		}
+		std::vector<float> bands(filterbank.getNumBands());
+		bench("LogFilterbank::apply", 1.0 / 50.0, [&] {
+			filterbank.apply(magnitude.data(), bands.data());
+			g_sink = bands[0];
+		});
+	}
+
+	// ------------------------------------------------------------------------
+	// MelExtractor::processFrame - one op = one 20ms hop at 22050Hz
+	// ------------------------------------------------------------------------
+	{
+		MelExtractor extractor;
+		auto frame = test_utils::generateSineWave(440.0f, 22050.0f, MelConfig::WIN_LENGTH);
+		std::vector<float> features(MelExtractor::getFeatureDim());
+		extractor.processFrame(frame.data(), MelConfig::WIN_LENGTH, features.data());
+		bench("MelExtractor::processFrame", 1.0 / 50.0, [&] {
+			extractor.processFrame(frame.data(), MelConfig::WIN_LENGTH, features.data());
+			g_sink = features[0];
+		});
+	}
+
+	// ------------------------------------------------------------------------
+	// CqtExtractor::processFrame - one op = one 200ms hop at 44100Hz
+	// ------------------------------------------------------------------------
+	{
+		auto audio = test_utils::generateSineWave(
+			220.0f, 44100.0f, CqtExtractor::getMaxFilterLength());
+		std::vector<float> bins(CqtConfig::N_BINS);
+
+		CqtExtractor timeDomain(CqtMethod::TimeDomain);
+		bench("CqtExtractor (TimeDomain)", 1.0 / 5.0, [&] {
+			timeDomain.processFrame(audio.data(), audio.size(), bins.data());
+			g_sink = bins[0];
+		});
+
+		CqtExtractor sparseFft(CqtMethod::SparseFft);
+		bench("CqtExtractor (SparseFft)", 1.0 / 5.0, [&] {
+			sparseFft.processFrame(audio.data(), audio.size(), bins.data());
+			g_sink = bins[0];
+		});
+
+		CqtExtractor multirate(CqtMethod::Multirate);
+		bench("CqtExtractor (Multirate)", 1.0 / 5.0, [&] {
+			multirate.processFrame(audio.data(), audio.size(), bins.data());
+			g_sink = bins[0];
+		});
+	}
+
+	// ------------------------------------------------------------------------
+	// Resampler::processStreaming - one op = 100ms at 44100Hz
+	// ------------------------------------------------------------------------
+	{
+		Resampler resampler;
+		auto input = test_utils::generateNoise(4410, 0.5f, 42);
+		std::vector<float> output(resampler.getOutputSize(4410) + 64);
+		bench("Resampler::processStreaming", 0.1, [&] {
+			resampler.processStreaming(input.data(), 4410,
+			                           output.data(), static_cast<int>(output.size()));
+			g_sink = output[0];
+		});
+	}
+
+	// ------------------------------------------------------------------------
+	// AutocorrBpmEstimator - one op = a 512-frame window (10.24s at 50 FPS)
+	// ------------------------------------------------------------------------
+	{
+		constexpr size_t FRAMES = 512;
+		std::vector<float> beat(FRAMES, 0.0f);
+		std::vector<float> down(FRAMES, 0.0f);
+		for (size_t i = 0; i < FRAMES; i += 25) {  // 120 BPM at 50 FPS
+			beat[i] = 1.0f;
+		}
+		AutocorrBpmEstimator estimator(FRAMES);
+		bench("AutocorrBpmEstimator::compute", 512.0 / 50.0, [&] {
+			g_sink = estimator.compute(beat.data(), down.data(), FRAMES);
+		});
+	}
+
+#ifdef ONNX_ENABLED
+	// ------------------------------------------------------------------------
+	// OnnxModel::infer - one op = one 20ms frame
+	// ------------------------------------------------------------------------
+	{
+		OnnxModel model;
+		if (model.load(test_utils::getModelPath())) {
+			auto features = test_utils::generateNoise(
+				MelConfig::MODEL_INPUT_DIM, 0.1f, 42);
+			ModelOutput output;
+			bench("OnnxModel::infer (BeatNet)", 1.0 / 50.0, [&] {
+				model.infer(features.data(), output);
+				g_sink = output.beatActivation;
+			});
+		} else {
+			printf("%-32s skipped (model not found)\n", "OnnxModel::infer (BeatNet)");
+		}
+	}
+#else
+	printf("%-32s skipped (ONNX disabled)\n", "OnnxModel::infer (BeatNet)");
+#endif
+
+	printf("================================================================================\n");
+	return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * TrackAnalysisPool unit tests
+ *
+ * Exercises the pool mechanics (submission, stealing, completion accounting)
+ * with a synthetic decode function. Model-backed results are covered by the
+ * E2E tests; without models the engines produce empty results but the
+ * scheduling paths are identical.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "TrackAnalysisPool.hpp"
+#include "test_utils.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("TrackAnalysisPool completes every submitted job", "[pool]") {
+	std::atomic<int> completed{0};
+	std::mutex seenMutex;
+	std::set<std::string> seen;
+
+	TrackAnalysisPool pool(
+		4, "", "",
+		[](const std::string&, std::vector<float>& samples) {
+			samples = test_utils::generateSineWave(440.0f, 44100.0f, 4410);
+			return true;
+		},
+		[&](const std::string& path, const Engine::AnalysisResult& result) {
+			REQUIRE(result.bpm == 0.0f);  // No models loaded
+			REQUIRE_FALSE(result.key.valid);
+			completed++;
+			std::lock_guard<std::mutex> lock(seenMutex);
+			seen.insert(path);
+		});
+
+	REQUIRE(pool.workerCount() == 4);
+
+	constexpr int NUM_JOBS = 32;
+	for (int i = 0; i < NUM_JOBS; i++) {
+		pool.submit("track-" + std::to_string(i));
+	}
+	pool.wait();
+
+	REQUIRE(completed.load() == NUM_JOBS);
+	REQUIRE(seen.size() == NUM_JOBS);
+}
+
+TEST_CASE("TrackAnalysisPool reports failed decodes as empty results", "[pool]") {
+	std::atomic<int> completed{0};
+
+	TrackAnalysisPool pool(
+		2, "", "",
+		[](const std::string&, std::vector<float>&) { return false; },
+		[&](const std::string&, const Engine::AnalysisResult& result) {
+			REQUIRE(result.bpm == 0.0f);
+			REQUIRE_FALSE(result.key.valid);
+			completed++;
+		});
+
+	for (int i = 0; i < 8; i++) {
+		pool.submit("broken-" + std::to_string(i));
+	}
+	pool.wait();
+
+	REQUIRE(completed.load() == 8);
+}
+
+TEST_CASE("TrackAnalysisPool wait returns immediately when idle", "[pool]") {
+	TrackAnalysisPool pool(
+		2, "", "",
+		[](const std::string&, std::vector<float>&) { return false; },
+		nullptr);
+
+	pool.wait();
+	SUCCEED();
+}
@@ -239,6 +239,42 @@ TEST_CASE("ActivationBuffer auto-computes BPM", "[bpm][buffer][auto]") {
 	REQUIRE(std::abs(cachedBpm - targetBpm) <= 2.0f);
 }
 
+TEST_CASE("AutocorrBpmEstimator respects fps parameter", "[bpm][fps]") {
+	// 75 BPM is exactly 10 frames per beat at 12.5 FPS, so the low-rate
+	// lag grid doesn't quantize the target
+	const float targetBpm = 75.0f;
+	const float fps = 12.5f;  // Decimated tier rate
+	const size_t numFrames = 400;  // 32 seconds at 12.5 FPS
+
+	auto [beats, downbeats] = generateBeatPattern(targetBpm, numFrames, fps);
+
+	float detectedBpm = AutocorrBpmEstimator::estimate(
+		beats.data(), downbeats.data(), numFrames, false, fps);
+
+	INFO("Detected BPM at 12.5 FPS: " << detectedBpm);
+
+	REQUIRE(std::abs(detectedBpm - targetBpm) <= 2.0f);
+}
+
+TEST_CASE("ActivationBuffer long-session estimate stays accurate", "[bpm][buffer][tiers]") {
+	ActivationBuffer buffer;
+
+	const float targetBpm = 128.0f;
+	const size_t numFrames = 3000;  // 60 seconds, fills both tiers
+
+	auto [beats, downbeats] = generateBeatPattern(targetBpm, numFrames);
+
+	for (size_t i = 0; i < numFrames; i++) {
+		buffer.push(beats[i], downbeats[i]);
+	}
+
+	float bpm = buffer.estimateBpm();
+	INFO("Tiered BPM: " << bpm);
+
+	// Short and long tiers agree, so the cross-check must not disturb it
+	REQUIRE(std::abs(bpm - targetBpm) <= 2.0f);
+}
+
 TEST_CASE("ActivationBuffer ring buffer ordering", "[bpm][buffer][ring]") {
 	// Use buffer that's larger than MIN_FRAMES_FOR_BPM (100)
 	ActivationBuffer buffer(150);
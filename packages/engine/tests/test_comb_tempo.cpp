@@ -0,0 +1,101 @@
+/**
+ * CombTempo unit tests
+ *
+ * Tests the incremental comb-filterbank tempo tracker.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "CombTempo.hpp"
+#include "AutocorrBpm.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("CombTempoTracker constants", "[comb][constants]") {
+	REQUIRE(CombTempoTracker::FPS == 50.0f);
+	REQUIRE(CombTempoTracker::MIN_BPM == 60.0f);
+	REQUIRE(CombTempoTracker::MAX_BPM == 180.0f);
+	REQUIRE(CombTempoTracker::BPM_STEP == 0.5f);
+	REQUIRE(CombTempoTracker::NUM_BANDS == 241);
+}
+
+/**
+ * Push a synthetic beat pattern at a specific BPM through the tracker
+ */
+static void pushBeatPattern(CombTempoTracker& tracker, float bpm,
+                            size_t numFrames, float fps = 50.0f) {
+	float framesPerBeat = fps * 60.0f / bpm;
+	for (size_t i = 0; i < numFrames; i++) {
+		float beatPhase = std::fmod(static_cast<float>(i), framesPerBeat);
+		float activation = 0.0f;
+		if (beatPhase < framesPerBeat * 0.1f) {
+			float t = beatPhase / (framesPerBeat * 0.1f);
+			activation = 1.0f - t;  // Decay from 1.0
+		}
+		tracker.push(activation);
+	}
+}
+
+TEST_CASE("CombTempoTracker insufficient data", "[comb][edge]") {
+	CombTempoTracker tracker;
+
+	// Less than 2 seconds of frames should return 0
+	pushBeatPattern(tracker, 120.0f, 50);
+	REQUIRE(tracker.estimate() == 0.0f);
+}
+
+TEST_CASE("CombTempoTracker detects various tempos", "[comb][accuracy]") {
+	const size_t numFrames = 400;  // 8 seconds
+
+	// Test tempos in DJ range (octave correction won't change them)
+	std::vector<float> testBpms = {80.0f, 100.0f, 120.0f, 128.0f, 140.0f};
+
+	for (float targetBpm : testBpms) {
+		DYNAMIC_SECTION("detects " << targetBpm << " BPM") {
+			CombTempoTracker tracker;
+			pushBeatPattern(tracker, targetBpm, numFrames);
+
+			float detectedBpm = tracker.estimate(true);
+
+			INFO("Target BPM: " << targetBpm);
+			INFO("Detected BPM: " << detectedBpm);
+
+			// Should be within 2 BPM of target (with octave correction)
+			REQUIRE(std::abs(detectedBpm - targetBpm) <= 2.0f);
+		}
+	}
+}
+
+TEST_CASE("CombTempoTracker clear resets state", "[comb][edge]") {
+	CombTempoTracker tracker;
+	pushBeatPattern(tracker, 120.0f, 400);
+	REQUIRE(tracker.estimate() > 0.0f);
+	REQUIRE(tracker.frameCount() == 400);
+
+	tracker.clear();
+	REQUIRE(tracker.frameCount() == 0);
+	REQUIRE(tracker.estimate() == 0.0f);
+}
+
+TEST_CASE("ActivationBuffer comb estimate tracks pushes", "[comb][buffer]") {
+	ActivationBuffer buffer;
+
+	const float targetBpm = 128.0f;
+	const float framesPerBeat = 50.0f * 60.0f / targetBpm;
+
+	for (size_t i = 0; i < 400; i++) {
+		float beatPhase = std::fmod(static_cast<float>(i), framesPerBeat);
+		float activation = 0.0f;
+		if (beatPhase < framesPerBeat * 0.1f) {
+			activation = 1.0f - beatPhase / (framesPerBeat * 0.1f);
+		}
+		buffer.push(activation, 0.0f);
+	}
+
+	float combBpm = buffer.estimateCombBpm();
+	INFO("Comb BPM: " << combBpm);
+
+	REQUIRE(std::abs(combBpm - targetBpm) <= 2.0f);
+}
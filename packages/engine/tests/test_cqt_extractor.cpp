@@ -9,6 +9,7 @@
 #include "test_utils.hpp"
 
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <vector>
 
@@ -160,6 +161,175 @@ TEST_CASE("StreamingCqtExtractor frame count", "[cqt][streaming]") {
 	REQUIRE(framesProduced <= 15);
 }
 
+TEST_CASE("SparseFft engine matches TimeDomain output", "[cqt][sparse]") {
+	CqtExtractor timeDomain(CqtMethod::TimeDomain);
+	CqtExtractor sparseFft(CqtMethod::SparseFft);
+
+	REQUIRE(timeDomain.getMethod() == CqtMethod::TimeDomain);
+	REQUIRE(sparseFft.getMethod() == CqtMethod::SparseFft);
+
+	// Mix of frequencies spanning the CQT range
+	const int sampleRate = CqtConfig::SAMPLE_RATE;
+	const int maxFilterLen = CqtExtractor::getMaxFilterLength();
+
+	std::vector<float> audio(maxFilterLen);
+	for (int i = 0; i < maxFilterLen; i++) {
+		float t = static_cast<float>(i) / sampleRate;
+		audio[i] = 0.4f * std::sin(2.0f * M_PI * 110.0f * t)
+		         + 0.4f * std::sin(2.0f * M_PI * 440.0f * t)
+		         + 0.2f * std::sin(2.0f * M_PI * 880.0f * t);
+	}
+
+	std::vector<float> binsTime(CqtConfig::N_BINS);
+	std::vector<float> binsSparse(CqtConfig::N_BINS);
+	REQUIRE(timeDomain.processFrame(audio.data(), maxFilterLen, binsTime.data()));
+	REQUIRE(sparseFft.processFrame(audio.data(), maxFilterLen, binsSparse.data()));
+
+	// Outputs should agree to within the kernel sparsification error
+	for (int k = 0; k < CqtConfig::N_BINS; k++) {
+		INFO("Bin " << k << ": time=" << binsTime[k] << " sparse=" << binsSparse[k]);
+		REQUIRE(binsSparse[k] == Approx(binsTime[k]).margin(0.05f));
+	}
+
+	// Peak bins must match exactly
+	auto peak = [](const std::vector<float>& bins) {
+		return static_cast<int>(std::max_element(bins.begin(), bins.end()) - bins.begin());
+	};
+	REQUIRE(peak(binsSparse) == peak(binsTime));
+}
+
+TEST_CASE("Multirate engine matches TimeDomain output", "[cqt][multirate]") {
+	CqtExtractor timeDomain(CqtMethod::TimeDomain);
+	CqtExtractor multirate(CqtMethod::Multirate);
+
+	// Mix spanning the low octaves, where the decimated kernels do the work
+	const int sampleRate = CqtConfig::SAMPLE_RATE;
+	const int maxFilterLen = CqtExtractor::getMaxFilterLength();
+
+	std::vector<float> audio(maxFilterLen);
+	for (int i = 0; i < maxFilterLen; i++) {
+		float t = static_cast<float>(i) / sampleRate;
+		audio[i] = 0.4f * std::sin(2.0f * M_PI * 82.0f * t)
+		         + 0.4f * std::sin(2.0f * M_PI * 220.0f * t)
+		         + 0.2f * std::sin(2.0f * M_PI * 660.0f * t);
+	}
+
+	std::vector<float> binsTime(CqtConfig::N_BINS);
+	std::vector<float> binsMulti(CqtConfig::N_BINS);
+	REQUIRE(timeDomain.processFrame(audio.data(), maxFilterLen, binsTime.data()));
+	REQUIRE(multirate.processFrame(audio.data(), maxFilterLen, binsMulti.data()));
+
+	// Halfband passband ripple and edge clipping allow a slightly looser
+	// tolerance than the SparseFft parity check
+	for (int k = 0; k < CqtConfig::N_BINS; k++) {
+		INFO("Bin " << k << ": time=" << binsTime[k] << " multirate=" << binsMulti[k]);
+		REQUIRE(binsMulti[k] == Approx(binsTime[k]).margin(0.1f));
+	}
+
+	auto peak = [](const std::vector<float>& bins) {
+		return static_cast<int>(std::max_element(bins.begin(), bins.end()) - bins.begin());
+	};
+	REQUIRE(peak(binsMulti) == peak(binsTime));
+}
+
+TEST_CASE("Resonator engine detects sine peak", "[cqt][resonator]") {
+	StreamingCqtExtractor extractor(CqtMethod::Resonator);
+
+	// 3 seconds of 440 Hz, long enough for the resonators to settle
+	const int sampleRate = CqtConfig::SAMPLE_RATE;
+	const int totalSamples = sampleRate * 3;
+
+	std::vector<float> audio(totalSamples);
+	for (int i = 0; i < totalSamples; i++) {
+		float t = static_cast<float>(i) / sampleRate;
+		audio[i] = std::sin(2.0f * M_PI * 440.0f * t);
+	}
+
+	std::vector<float> cqtFrames(CqtConfig::N_BINS * 20);
+	int framesProduced = extractor.push(audio.data(), totalSamples,
+	                                     cqtFrames.data(), 20);
+	REQUIRE(framesProduced >= 5);
+
+	// Peak bin of the last frame should sit at 440 Hz like the kernel engines
+	const float* last = cqtFrames.data() + (framesProduced - 1) * CqtConfig::N_BINS;
+	int peakBin = 0;
+	for (int k = 1; k < CqtConfig::N_BINS; k++) {
+		if (last[k] > last[peakBin]) {
+			peakBin = k;
+		}
+	}
+
+	CqtExtractor reference;
+	const auto& freqs = reference.getCenterFrequencies();
+	INFO("Peak bin: " << peakBin << " at frequency " << freqs[peakBin] << " Hz");
+	REQUIRE(freqs[peakBin] > 400.0f);
+	REQUIRE(freqs[peakBin] < 480.0f);
+}
+
+TEST_CASE("Resonator frame schedule matches kernel engines", "[cqt][resonator]") {
+	StreamingCqtExtractor resonator(CqtMethod::Resonator);
+	StreamingCqtExtractor timeDomain(CqtMethod::TimeDomain);
+
+	const int sampleRate = CqtConfig::SAMPLE_RATE;
+	const int totalSamples = sampleRate * 2;
+
+	std::vector<float> audio(totalSamples);
+	for (int i = 0; i < totalSamples; i++) {
+		float t = static_cast<float>(i) / sampleRate;
+		audio[i] = std::sin(2.0f * M_PI * 440.0f * t);
+	}
+
+	// Same hop cadence regardless of chunking
+	std::vector<float> frames(CqtConfig::N_BINS * 20);
+	const int chunk = 4410;
+	int resonatorFrames = 0;
+	for (int offset = 0; offset < totalSamples; offset += chunk) {
+		resonatorFrames += resonator.push(audio.data() + offset, chunk,
+		                                   frames.data(), 20);
+	}
+	int timeDomainFrames = timeDomain.push(audio.data(), totalSamples,
+	                                        frames.data(), 20);
+
+	REQUIRE(resonatorFrames == timeDomainFrames);
+	REQUIRE(resonator.getFrameCount() == timeDomain.getFrameCount());
+}
+
+TEST_CASE("Kernel cache roundtrip", "[cqt][cache]") {
+	const int sampleRate = CqtConfig::SAMPLE_RATE;
+	const int maxFilterLen = CqtExtractor::getMaxFilterLength();
+
+	std::vector<float> audio(maxFilterLen);
+	for (int i = 0; i < maxFilterLen; i++) {
+		float t = static_cast<float>(i) / sampleRate;
+		audio[i] = 0.5f * std::sin(2.0f * M_PI * 220.0f * t)
+		         + 0.5f * std::sin(2.0f * M_PI * 523.25f * t);
+	}
+
+	std::remove("/tmp/cqt_kernels_v2.bin");
+	CqtExtractor::setKernelCachePath("/tmp");
+
+	// First construction synthesizes and writes the blob
+	std::vector<float> binsFresh(CqtConfig::N_BINS);
+	{
+		CqtExtractor extractor;
+		REQUIRE(extractor.processFrame(audio.data(), maxFilterLen, binsFresh.data()));
+	}
+
+	// Second construction loads the blob; output must be bit-exact
+	std::vector<float> binsCached(CqtConfig::N_BINS);
+	{
+		CqtExtractor extractor;
+		REQUIRE(extractor.processFrame(audio.data(), maxFilterLen, binsCached.data()));
+	}
+
+	CqtExtractor::setKernelCachePath("");
+	std::remove("/tmp/cqt_kernels_v2.bin");
+
+	for (int k = 0; k < CqtConfig::N_BINS; k++) {
+		REQUIRE(binsCached[k] == binsFresh[k]);
+	}
+}
+
 TEST_CASE("CQT output range", "[cqt][range]") {
 	CqtExtractor extractor;
 
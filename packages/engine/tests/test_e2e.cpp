@@ -211,6 +211,59 @@ TEST_CASE("Engine dual pipeline processing", "[e2e][key]") {
     REQUIRE(!key.notation.empty());
     REQUIRE(!key.camelot.empty());
     REQUIRE(key.confidence > 0.0f);
+
+    // Every stage should have accumulated telemetry
+    auto stats = engine.getStats();
+    INFO("resample: " << stats.resample.totalMicros << "us over " << stats.resample.calls);
+    INFO("mel: " << stats.mel.totalMicros << "us, beatnet: " << stats.beatnet.totalMicros
+         << "us, cqt: " << stats.cqt.totalMicros << "us, key: "
+         << stats.keyInference.totalMicros << "us");
+    REQUIRE(stats.resample.calls > 0);
+    REQUIRE(stats.mel.calls > 0);
+    REQUIRE(stats.beatnet.calls > 0);
+    REQUIRE(stats.cqt.calls > 0);
+    REQUIRE(stats.keyInference.calls > 0);
+    REQUIRE(stats.bpmFrames == bpmFrames);
+    REQUIRE(stats.cqtFrames == keyFrames);
+    REQUIRE(stats.keyInferences > 0);
+}
+
+TEST_CASE("Engine offline analyzeBuffer", "[e2e][offline]") {
+    Engine engine;
+
+    std::string bpmModelPath = test_utils::getModelPath();
+    std::string keyModelPath = test_utils::getModelsDir() + "keynet.onnx";
+
+    if (!engine.loadModel(bpmModelPath)) {
+        SKIP("BeatNet model not available");
+    }
+    if (!engine.loadKeyModel(keyModelPath)) {
+        SKIP("MusicalKeyCNN model not available");
+    }
+
+    // 25 seconds of a C major chord with a 120 BPM click on top
+    const float duration = 25.0f;
+    const int totalSamples = static_cast<int>(Engine::SAMPLE_RATE * duration);
+    const int beatPeriod = Engine::SAMPLE_RATE / 2;  // 120 BPM
+    std::vector<float> audio(totalSamples);
+
+    for (int i = 0; i < totalSamples; i++) {
+        float t = static_cast<float>(i) / Engine::SAMPLE_RATE;
+        audio[i] = 0.25f * std::sin(2.0f * M_PI * 261.63f * t)
+                 + 0.25f * std::sin(2.0f * M_PI * 329.63f * t)
+                 + 0.25f * std::sin(2.0f * M_PI * 392.00f * t);
+        if (i % beatPeriod < 441) {
+            audio[i] += 0.5f;
+        }
+    }
+
+    auto result = engine.analyzeBuffer(audio.data(), audio.size());
+
+    INFO("BPM: " << result.bpm);
+    INFO("Key: " << result.key.notation << " (" << result.key.camelot << ")");
+    REQUIRE(result.bpm > 0.0f);
+    REQUIRE(result.key.valid);
+    REQUIRE(!result.key.camelot.empty());
 }
 
 #else // !ONNX_ENABLED
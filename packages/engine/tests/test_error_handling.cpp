@@ -12,6 +12,7 @@
 #include "test_utils.hpp"
 
 #include <cmath>
+#include <cstdio>
 #include <vector>
 
 using namespace engine;
@@ -76,6 +77,116 @@ TEST_CASE("Engine processes audio without loaded model", "[error][engine]") {
 
 #endif // ONNX_ENABLED
 
+TEST_CASE("resolveModelPath falls back to float32", "[error][precision]") {
+	const std::string fp32 = "/tmp/engine_precision_test.onnx";
+	const std::string int8 = "/tmp/engine_precision_test.int8.onnx";
+	std::remove(fp32.c_str());
+	std::remove(int8.c_str());
+
+	SECTION("missing variant resolves to the given path") {
+		REQUIRE(resolveModelPath(fp32, ModelPrecision::Int8) == fp32);
+		REQUIRE(resolveModelPath(fp32, ModelPrecision::Float16) == fp32);
+	}
+
+	SECTION("shipped variant wins for its precision only") {
+		FILE* f = fopen(int8.c_str(), "wb");
+		REQUIRE(f != nullptr);
+		fclose(f);
+
+		REQUIRE(resolveModelPath(fp32, ModelPrecision::Int8) == int8);
+		REQUIRE(resolveModelPath(fp32, ModelPrecision::Float16) == fp32);
+		REQUIRE(resolveModelPath(fp32, ModelPrecision::Float32) == fp32);
+
+		std::remove(int8.c_str());
+	}
+}
+
+TEST_CASE("Engine input sample rate validation", "[error][engine]") {
+	Engine engine;
+
+	REQUIRE(engine.setInputSampleRate(48000));
+	REQUIRE(engine.setInputSampleRate(44100));
+	REQUIRE_FALSE(engine.setInputSampleRate(22050));
+	REQUIRE_FALSE(engine.setInputSampleRate(0));
+
+	// Processing at 48 kHz without models still returns no results
+	REQUIRE(engine.setInputSampleRate(48000));
+	auto audio = test_utils::generateSineWave(440.0f, 48000.0f, 48000);
+	std::vector<Engine::FrameResult> results(100);
+	REQUIRE(engine.processAudio(audio.data(), audio.size(),
+	                            results.data(), results.size()) == 0);
+}
+
+TEST_CASE("Engine handles multichannel input without loaded models", "[error][engine]") {
+	Engine engine;
+
+	const int frames = 44100;
+	auto mono = test_utils::generateSineWave(440.0f, 44100.0f, frames);
+	std::vector<Engine::FrameResult> results(100);
+
+	SECTION("interleaved stereo") {
+		std::vector<float> stereo(static_cast<size_t>(frames) * 2);
+		for (int i = 0; i < frames; i++) {
+			stereo[2 * i] = mono[i];
+			stereo[2 * i + 1] = mono[i];
+		}
+		int produced = engine.processAudioInterleaved(stereo.data(), frames, 2,
+		                                               results.data(), results.size());
+		REQUIRE(produced == 0);
+	}
+
+	SECTION("planar four channels") {
+		const float* channels[4] = {mono.data(), mono.data(), mono.data(), mono.data()};
+		int produced = engine.processAudioPlanar(channels, frames, 4,
+		                                          results.data(), results.size());
+		REQUIRE(produced == 0);
+	}
+
+	SECTION("mono forwards to processAudio") {
+		int produced = engine.processAudioInterleaved(mono.data(), frames, 1,
+		                                               results.data(), results.size());
+		REQUIRE(produced == 0);
+	}
+}
+
+TEST_CASE("Engine analyzeBuffer without loaded models", "[error][engine]") {
+	Engine engine;
+
+	SECTION("empty buffer") {
+		auto result = engine.analyzeBuffer(nullptr, 0);
+		REQUIRE(result.bpm == 0.0f);
+		REQUIRE_FALSE(result.key.valid);
+	}
+
+	SECTION("audio with no models returns empty result") {
+		auto audio = test_utils::generateSineWave(440.0f, 44100.0f, 44100);
+		auto result = engine.analyzeBuffer(audio.data(), audio.size());
+		REQUIRE(result.bpm == 0.0f);
+		REQUIRE_FALSE(result.key.valid);
+	}
+}
+
+TEST_CASE("Engine stats start zeroed and stay consistent", "[error][engine]") {
+	Engine engine;
+
+	auto stats = engine.getStats();
+	REQUIRE(stats.resample.calls == 0);
+	REQUIRE(stats.mel.totalMicros == 0);
+	REQUIRE(stats.beatnet.calls == 0);
+	REQUIRE(stats.cqt.lastMicros == 0);
+	REQUIRE(stats.keyInference.calls == 0);
+	REQUIRE(stats.bpmFrames == 0);
+	REQUIRE(stats.cqtFrames == 0);
+	REQUIRE(stats.keyInferences == 0);
+
+	// Without models no stage runs, so processing leaves the stats untouched
+	auto audio = test_utils::generateSineWave(440.0f, 44100.0f, 44100);
+	engine.processAudio(audio.data(), audio.size(), nullptr, 0);
+	stats = engine.getStats();
+	REQUIRE(stats.resample.calls == 0);
+	REQUIRE(stats.cqt.calls == 0);
+}
+
 // ============================================================================
 // Edge Cases - Empty and Zero Input
 // ============================================================================
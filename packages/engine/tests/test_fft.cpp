@@ -106,6 +106,40 @@ TEST_CASE("FFT sine wave detection", "[fft]") {
     }
 }
 
+TEST_CASE("FFT inverse roundtrip", "[fft]") {
+    SECTION("odd size (1411)") {
+        constexpr size_t N = MelConfig::FFT_SIZE;
+        FFT fft(N);
+
+        auto signal = test_utils::generateSineWave(440.0f, 22050.0f, N);
+        std::vector<std::complex<float>> spectrum(fft.getOutputSize());
+        std::vector<float> reconstructed(N);
+
+        fft.forward(signal.data(), spectrum.data());
+        fft.inverse(spectrum.data(), reconstructed.data());
+
+        for (size_t i = 0; i < N; i++) {
+            REQUIRE(reconstructed[i] == Approx(signal[i]).margin(1e-4f));
+        }
+    }
+
+    SECTION("even size (1024)") {
+        constexpr size_t N = 1024;
+        FFT fft(N);
+
+        auto signal = test_utils::generateSineWave(440.0f, 22050.0f, N);
+        std::vector<std::complex<float>> spectrum(fft.getOutputSize());
+        std::vector<float> reconstructed(N);
+
+        fft.forward(signal.data(), spectrum.data());
+        fft.inverse(spectrum.data(), reconstructed.data());
+
+        for (size_t i = 0; i < N; i++) {
+            REQUIRE(reconstructed[i] == Approx(signal[i]).margin(1e-4f));
+        }
+    }
+}
+
 TEST_CASE("FFT Parseval's theorem", "[fft]") {
     // Energy in time domain should equal energy in frequency domain
     constexpr size_t N = MelConfig::FFT_SIZE;  // 1411
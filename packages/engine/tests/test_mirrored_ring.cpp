@@ -0,0 +1,76 @@
+/**
+ * MirroredRing unit tests
+ *
+ * Tests the double-mapped ring buffer used by the streaming extractors
+ * and the activation buffer for zero-copy contiguous windows.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "MirroredRing.hpp"
+
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("MirroredRing capacity covers the request", "[ring]") {
+	MirroredRing ring(512);
+	REQUIRE(ring.capacity() >= 512);
+}
+
+TEST_CASE("MirroredRing mirrors writes across the wrap", "[ring]") {
+	MirroredRing ring(256);
+	const size_t cap = ring.capacity();
+
+	// Write a recognizable ramp one element at a time, wrapping the ring
+	for (size_t i = 0; i < cap + 100; i++) {
+		float value = static_cast<float>(i);
+		ring.store(i % cap, &value, 1);
+	}
+
+	// A window starting near the logical end must read contiguously into
+	// the mirror: the last cap values written were (100 .. cap+99)
+	size_t start = 100 % cap;
+	const float* window = ring.window(start);
+	for (size_t i = 0; i < cap; i++) {
+		REQUIRE(window[i] == static_cast<float>(100 + i));
+	}
+}
+
+TEST_CASE("MirroredRing block store wraps automatically", "[ring]") {
+	MirroredRing ring(64);
+	const size_t cap = ring.capacity();
+	ring.fill(0.0f);
+
+	// Store a block that runs past the logical end
+	std::vector<float> block(32);
+	for (size_t i = 0; i < block.size(); i++) {
+		block[i] = static_cast<float>(i + 1);
+	}
+	size_t pos = cap - 10;
+	ring.store(pos, block.data(), block.size());
+
+	// Readable contiguously from pos...
+	const float* window = ring.window(pos);
+	for (size_t i = 0; i < block.size(); i++) {
+		REQUIRE(window[i] == block[i]);
+	}
+
+	// ...and the overhang landed at the logical start
+	const float* base = ring.window(0);
+	for (size_t i = 0; i < block.size() - 10; i++) {
+		REQUIRE(base[i] == block[10 + i]);
+	}
+}
+
+TEST_CASE("MirroredRing fill clears both images", "[ring]") {
+	MirroredRing ring(64);
+	const size_t cap = ring.capacity();
+
+	float value = 7.0f;
+	ring.store(cap - 1, &value, 1);
+	ring.fill(0.0f);
+
+	const float* window = ring.window(cap - 1);
+	REQUIRE(window[0] == 0.0f);
+	REQUIRE(ring.window(0)[cap - 1] == 0.0f);
+}
@@ -11,6 +11,7 @@
 #include "catch_amalgamated.hpp"
 #include "MelExtractor.hpp"
 #include "OnnxModel.hpp"
+#include "OnnxRuntime.hpp"
 #include "test_utils.hpp"
 
 #include <cmath>
@@ -176,6 +177,60 @@ TEST_CASE("OnnxModel LSTM state persistence", "[onnx]") {
     REQUIRE(outputsDiffer);
 }
 
+TEST_CASE("OnnxModel loads under a tuned session config", "[onnx]") {
+    auto& runtime = engine::OnnxRuntime::instance();
+    const auto saved = runtime.sessionConfig();
+
+    OnnxRuntime::SessionConfig config;
+    config.provider = OnnxRuntime::SessionConfig::Provider::Cpu;
+    config.optLevel = OnnxRuntime::SessionConfig::OptLevel::Basic;
+    config.intraOpThreads = 1;
+    runtime.setSessionConfig(config);
+
+    OnnxModel model;
+    std::string modelPath = test_utils::getModelPath();
+    if (!model.load(modelPath)) {
+        runtime.setSessionConfig(saved);
+        SKIP("Model file not available");
+    }
+
+    std::vector<float> features(OnnxModel::INPUT_DIM, 0.5f);
+    ModelOutput output;
+    REQUIRE(model.infer(features.data(), output));
+    REQUIRE(std::isfinite(output.beatActivation));
+
+    runtime.setSessionConfig(saved);
+}
+
+TEST_CASE("OnnxModel optimized-model cache roundtrip", "[onnx]") {
+    auto& runtime = engine::OnnxRuntime::instance();
+    runtime.setOptimizedModelCachePath("/tmp");
+
+    std::string modelPath = test_utils::getModelPath();
+    std::vector<float> features(OnnxModel::INPUT_DIM, 0.5f);
+    ModelOutput raw, cached;
+
+    // First load serializes the optimized graph, second loads it back
+    {
+        OnnxModel model;
+        if (!model.load(modelPath)) {
+            runtime.setOptimizedModelCachePath("");
+            SKIP("Model file not available");
+        }
+        REQUIRE(model.infer(features.data(), raw));
+    }
+    {
+        OnnxModel model;
+        REQUIRE(model.load(modelPath));
+        REQUIRE(model.infer(features.data(), cached));
+    }
+    runtime.setOptimizedModelCachePath("");
+
+    // The optimized graph must compute the same function
+    REQUIRE(cached.beatActivation == Approx(raw.beatActivation).margin(1e-5));
+    REQUIRE(cached.downbeatActivation == Approx(raw.downbeatActivation).margin(1e-5));
+}
+
 #else // !ONNX_ENABLED
 
 TEST_CASE("ONNX tests skipped - ONNX not enabled", "[onnx]") {
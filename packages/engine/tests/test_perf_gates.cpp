@@ -0,0 +1,127 @@
+/**
+ * Performance regression gates
+ *
+ * Asserts throughput floors on the streaming hot paths so a slowdown (like a
+ * per-frame allocation sneaking into a push loop) fails the suite instead of
+ * landing silently. Floors are machine-calibrated and live in
+ * test-data/perf_baselines.txt - recalibrate there when the reference machine
+ * changes, not here.
+ *
+ * Tagged [!benchmark] so the cases are hidden from the default run (timing
+ * under a debugger or sanitizer is meaningless). Run them explicitly:
+ *
+ *     ./engine_tests "[!benchmark]"
+ *
+ * Catch2's BENCHMARK blocks report the detailed distributions; they do not
+ * feed assertions, so the floor checks use their own median timing.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "CqtExtractor.hpp"
+#include "MelExtractor.hpp"
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace engine;
+
+namespace {
+
+/**
+ * Read a throughput floor (x realtime) from test-data/perf_baselines.txt
+ * @return The calibrated floor, or fallback if the file or key is missing
+ */
+double baseline(const std::string& key, double fallback) {
+	std::ifstream file(test_utils::getTestDataDir() + "perf_baselines.txt");
+	std::string word;
+	while (file >> word) {
+		if (word[0] == '#') {
+			std::getline(file, word);
+			continue;
+		}
+		double value = 0.0;
+		if (!(file >> value)) {
+			break;
+		}
+		if (word == key) {
+			return value;
+		}
+	}
+	return fallback;
+}
+
+/**
+ * Median realtime multiple over repeated runs of fn
+ * @param audioSeconds Seconds of audio one run of fn consumes
+ */
+template <typename Fn>
+double realtimeMultiple(double audioSeconds, Fn&& fn) {
+	constexpr int RUNS = 5;
+	std::vector<double> multiples(RUNS);
+	fn();  // Warmup
+	for (int r = 0; r < RUNS; r++) {
+		const auto start = std::chrono::steady_clock::now();
+		fn();
+		const double elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+		multiples[r] = audioSeconds / elapsed;
+	}
+	std::sort(multiples.begin(), multiples.end());
+	return multiples[RUNS / 2];
+}
+
+} // namespace
+
+TEST_CASE("StreamingMelExtractor::push sustains realtime floor", "[!benchmark]") {
+	StreamingMelExtractor extractor;
+
+	// 5 seconds of noise at the mel pipeline rate, pushed in 100ms chunks
+	constexpr int CHUNK = MelConfig::SAMPLE_RATE / 10;
+	constexpr int CHUNKS = 50;
+	auto audio = test_utils::generateNoise(CHUNK * CHUNKS, 0.1f, 42);
+	std::vector<float> features(MelExtractor::getFeatureDim() * 16);
+
+	const double multiple = realtimeMultiple(CHUNKS * 0.1, [&] {
+		extractor.reset();
+		for (int c = 0; c < CHUNKS; c++) {
+			extractor.push(audio.data() + c * CHUNK, CHUNK, features.data(), 16);
+		}
+	});
+	const double floor = baseline("mel_push", 50.0);
+
+	INFO("Measured " << multiple << "x realtime, floor " << floor << "x");
+	REQUIRE(multiple >= floor);
+
+	BENCHMARK("mel push 100ms") {
+		return extractor.push(audio.data(), CHUNK, features.data(), 16);
+	};
+}
+
+TEST_CASE("StreamingCqtExtractor::push sustains realtime floor", "[!benchmark]") {
+	StreamingCqtExtractor extractor;
+
+	// 5 seconds of noise at 44100Hz, pushed in 100ms chunks
+	constexpr int CHUNK = 4410;
+	constexpr int CHUNKS = 50;
+	auto audio = test_utils::generateNoise(CHUNK * CHUNKS, 0.1f, 42);
+	std::vector<float> cqtFrames(CqtConfig::N_BINS * 8);
+
+	const double multiple = realtimeMultiple(CHUNKS * 0.1, [&] {
+		extractor.reset();
+		for (int c = 0; c < CHUNKS; c++) {
+			extractor.push(audio.data() + c * CHUNK, CHUNK, cqtFrames.data(), 8);
+		}
+	});
+	const double floor = baseline("cqt_push", 20.0);
+
+	INFO("Measured " << multiple << "x realtime, floor " << floor << "x");
+	REQUIRE(multiple >= floor);
+
+	BENCHMARK("cqt push 100ms") {
+		return extractor.push(audio.data(), CHUNK, cqtFrames.data(), 8);
+	};
+}
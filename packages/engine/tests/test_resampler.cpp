@@ -194,6 +194,101 @@ TEST_CASE("Resampler streaming mode", "[resampler][streaming]") {
 	REQUIRE(maxVal > 0.8f);
 }
 
+TEST_CASE("Resampler rational 48000 to 44100", "[resampler][rational]") {
+	Resampler resampler(48000, 44100);
+
+	// 1 second of 440 Hz at 48 kHz
+	const int inputSize = 48000;
+	std::vector<float> input(inputSize);
+	for (int i = 0; i < inputSize; i++) {
+		float t = static_cast<float>(i) / 48000.0f;
+		input[i] = std::sin(2.0f * M_PI * 440.0f * t);
+	}
+
+	REQUIRE(resampler.getOutputSize(inputSize) == 44100);
+
+	std::vector<float> output(resampler.getOutputSize(inputSize));
+	int outputSize = resampler.process(input.data(), inputSize, output.data());
+	REQUIRE(outputSize == 44100);
+
+	// Frequency must survive the 147:160 conversion: 440 Hz at 44100 Hz
+	// gives ~880 zero crossings per second
+	int zeroCrossings = 0;
+	for (int i = 1; i < outputSize; i++) {
+		if ((output[i] >= 0) != (output[i-1] >= 0)) {
+			zeroCrossings++;
+		}
+	}
+	float duration = static_cast<float>(outputSize) / 44100.0f;
+	float expectedCrossings = 880.0f * duration;
+
+	INFO("Zero crossings: " << zeroCrossings);
+	INFO("Expected: ~" << expectedCrossings);
+	REQUIRE(zeroCrossings > expectedCrossings * 0.95f);
+	REQUIRE(zeroCrossings < expectedCrossings * 1.05f);
+}
+
+TEST_CASE("Resampler rational 48000 to 22050 direct", "[resampler][rational]") {
+	Resampler resampler(48000, 22050);
+
+	const int inputSize = 48000;
+	std::vector<float> input(inputSize);
+	for (int i = 0; i < inputSize; i++) {
+		float t = static_cast<float>(i) / 48000.0f;
+		input[i] = std::sin(2.0f * M_PI * 440.0f * t);
+	}
+
+	std::vector<float> output(resampler.getOutputSize(inputSize));
+	int outputSize = resampler.process(input.data(), inputSize, output.data());
+	REQUIRE(outputSize == 22050);
+
+	int zeroCrossings = 0;
+	for (int i = 1; i < outputSize; i++) {
+		if ((output[i] >= 0) != (output[i-1] >= 0)) {
+			zeroCrossings++;
+		}
+	}
+	float expectedCrossings = 880.0f * static_cast<float>(outputSize) / 22050.0f;
+
+	INFO("Zero crossings: " << zeroCrossings);
+	REQUIRE(zeroCrossings > expectedCrossings * 0.95f);
+	REQUIRE(zeroCrossings < expectedCrossings * 1.05f);
+}
+
+TEST_CASE("Resampler rational streaming matches one-shot", "[resampler][rational][streaming]") {
+	Resampler resampler(48000, 44100);
+
+	const int chunkSize = 4800;  // 100ms at 48 kHz
+	const int numChunks = 10;
+	const int totalInput = chunkSize * numChunks;
+
+	std::vector<float> input(totalInput);
+	for (int i = 0; i < totalInput; i++) {
+		float t = static_cast<float>(i) / 48000.0f;
+		input[i] = std::sin(2.0f * M_PI * 440.0f * t);
+	}
+
+	// One-shot reference
+	std::vector<float> reference(resampler.getOutputSize(totalInput));
+	int referenceSize = resampler.process(input.data(), totalInput, reference.data());
+
+	// Chunked streaming from a fresh state
+	resampler.reset();
+	std::vector<float> streamed;
+	std::vector<float> chunkOutput(chunkSize);
+	for (int chunk = 0; chunk < numChunks; chunk++) {
+		int produced = resampler.processStreaming(input.data() + chunk * chunkSize,
+		                                           chunkSize, chunkOutput.data(), chunkSize);
+		streamed.insert(streamed.end(), chunkOutput.begin(), chunkOutput.begin() + produced);
+	}
+
+	// Same zero history and phase carry, so the outputs match exactly
+	REQUIRE(static_cast<int>(streamed.size()) == referenceSize);
+	for (int i = 0; i < referenceSize; i++) {
+		REQUIRE(streamed[i] == Approx(reference[i]).margin(1e-6f));
+	}
+}
+
 TEST_CASE("Resampler with mel extractor sample rate", "[resampler][mel]") {
 	// Test that resampled audio can be used with mel extractor
 	Resampler resampler(44100, 22050);
@@ -0,0 +1,108 @@
+/**
+ * SpscRing unit tests
+ *
+ * Single-threaded semantics plus a producer/consumer stress test that
+ * checks the sample stream arrives intact and in order.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "SpscRing.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("SpscRing basic write and read", "[spsc]") {
+	SpscRing ring(1000);
+	REQUIRE(ring.capacity() == 1024);  // Rounded up to a power of two
+	REQUIRE(ring.size() == 0);
+
+	float input[256];
+	for (int i = 0; i < 256; i++) {
+		input[i] = static_cast<float>(i);
+	}
+
+	REQUIRE(ring.write(input, 256) == 256);
+	REQUIRE(ring.size() == 256);
+
+	float output[256] = {};
+	REQUIRE(ring.read(output, 256) == 256);
+	REQUIRE(ring.size() == 0);
+	for (int i = 0; i < 256; i++) {
+		REQUIRE(output[i] == input[i]);
+	}
+
+	// Empty reads return 0
+	REQUIRE(ring.read(output, 256) == 0);
+}
+
+TEST_CASE("SpscRing partial write when full", "[spsc]") {
+	SpscRing ring(64);
+	std::vector<float> input(100, 1.0f);
+
+	// Only capacity fits; the remainder is reported, not silently dropped
+	REQUIRE(ring.write(input.data(), 100) == 64);
+	REQUIRE(ring.write(input.data(), 10) == 0);
+
+	std::vector<float> output(64);
+	REQUIRE(ring.read(output.data(), 64) == 64);
+	REQUIRE(ring.write(input.data(), 10) == 10);
+}
+
+TEST_CASE("SpscRing wraps correctly", "[spsc]") {
+	SpscRing ring(16);
+	float chunk[12];
+	float out[12];
+
+	// Repeated 12-sample transfers force wraps at every offset
+	for (int pass = 0; pass < 100; pass++) {
+		for (int i = 0; i < 12; i++) {
+			chunk[i] = static_cast<float>(pass * 12 + i);
+		}
+		REQUIRE(ring.write(chunk, 12) == 12);
+		REQUIRE(ring.read(out, 12) == 12);
+		for (int i = 0; i < 12; i++) {
+			REQUIRE(out[i] == chunk[i]);
+		}
+	}
+}
+
+TEST_CASE("SpscRing delivers an intact stream across threads", "[spsc]") {
+	constexpr size_t TOTAL = 1 << 20;
+	SpscRing ring(4096);
+
+	std::thread producer([&ring] {
+		float chunk[882];
+		size_t sent = 0;
+		while (sent < TOTAL) {
+			const size_t n = std::min<size_t>(882, TOTAL - sent);
+			for (size_t i = 0; i < n; i++) {
+				chunk[i] = static_cast<float>(sent + i);
+			}
+			size_t written = 0;
+			while (written < n) {
+				written += ring.write(chunk + written, n - written);
+			}
+			sent += n;
+		}
+	});
+
+	float out[1024];
+	size_t received = 0;
+	bool ordered = true;
+	while (received < TOTAL) {
+		const size_t n = ring.read(out, 1024);
+		for (size_t i = 0; i < n; i++) {
+			if (out[i] != static_cast<float>(received + i)) {
+				ordered = false;
+			}
+		}
+		received += n;
+	}
+	producer.join();
+
+	REQUIRE(ordered);
+	REQUIRE(received == TOTAL);
+	REQUIRE(ring.size() == 0);
+}
@@ -0,0 +1,200 @@
+/**
+ * State snapshot round-trip tests
+ *
+ * Each streaming component is run over the first half of a signal, its
+ * state serialized and restored into a fresh instance, and both are fed
+ * the second half - the restored instance must continue identically.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "Engine.hpp"
+#include "StateBlob.hpp"
+#include "Resampler.hpp"
+#include "MelExtractor.hpp"
+#include "CqtExtractor.hpp"
+#include "AutocorrBpm.hpp"
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace engine;
+using Catch::Approx;
+
+static std::vector<float> makeSine(int numSamples, float freq, float rate) {
+	std::vector<float> samples(numSamples);
+	for (int i = 0; i < numSamples; i++) {
+		samples[i] = std::sin(2.0f * M_PI * freq * static_cast<float>(i) / rate);
+	}
+	return samples;
+}
+
+TEST_CASE("Resampler snapshot continues identically", "[snapshot][resampler]") {
+	const int half = 10000;
+	auto input = makeSine(2 * half, 440.0f, 44100.0f);
+
+	Resampler original(44100, 22050);
+	std::vector<float> scratch(original.getOutputSize(half) + 8);
+	original.processStreaming(input.data(), half, scratch.data(),
+	                          static_cast<int>(scratch.size()));
+
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	Resampler restored(44100, 22050);
+	StateReader r(blob.data(), blob.size());
+	REQUIRE(restored.loadState(r));
+	REQUIRE(r.atEnd());
+
+	std::vector<float> a(scratch.size());
+	std::vector<float> b(scratch.size());
+	int countA = original.processStreaming(input.data() + half, half,
+	                                       a.data(), static_cast<int>(a.size()));
+	int countB = restored.processStreaming(input.data() + half, half,
+	                                       b.data(), static_cast<int>(b.size()));
+	REQUIRE(countA == countB);
+	for (int i = 0; i < countA; i++) {
+		REQUIRE(a[i] == b[i]);
+	}
+}
+
+TEST_CASE("Resampler snapshot rejects mismatched rates", "[snapshot][resampler]") {
+	Resampler original(48000, 44100);
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	Resampler other(44100, 22050);
+	StateReader r(blob.data(), blob.size());
+	REQUIRE_FALSE(other.loadState(r));
+}
+
+TEST_CASE("StreamingMelExtractor snapshot continues identically", "[snapshot][mel]") {
+	const int half = 22050;
+	auto input = makeSine(2 * half, 220.0f, 22050.0f);
+
+	StreamingMelExtractor original;
+	std::vector<float> scratch(200 * MelConfig::MODEL_INPUT_DIM);
+	original.push(input.data(), half, scratch.data(), 200);
+
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	StreamingMelExtractor restored;
+	StateReader r(blob.data(), blob.size());
+	REQUIRE(restored.loadState(r));
+	REQUIRE(r.atEnd());
+
+	std::vector<float> a(scratch.size());
+	std::vector<float> b(scratch.size());
+	int framesA = original.push(input.data() + half, half, a.data(), 200);
+	int framesB = restored.push(input.data() + half, half, b.data(), 200);
+	REQUIRE(framesA > 0);
+	REQUIRE(framesA == framesB);
+	for (int i = 0; i < framesA * MelConfig::MODEL_INPUT_DIM; i++) {
+		REQUIRE(a[i] == b[i]);
+	}
+}
+
+TEST_CASE("StreamingCqtExtractor snapshot continues identically", "[snapshot][cqt]") {
+	const int half = 2 * 44100;
+	auto input = makeSine(2 * half, 440.0f, 44100.0f);
+
+	StreamingCqtExtractor original;
+	std::vector<float> scratch(40 * CqtConfig::N_BINS);
+	original.push(input.data(), half, scratch.data(), 40);
+
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	StreamingCqtExtractor restored;
+	StateReader r(blob.data(), blob.size());
+	REQUIRE(restored.loadState(r));
+	REQUIRE(r.atEnd());
+	REQUIRE(restored.getFrameCount() == original.getFrameCount());
+
+	std::vector<float> a(scratch.size());
+	std::vector<float> b(scratch.size());
+	int framesA = original.push(input.data() + half, half, a.data(), 40);
+	int framesB = restored.push(input.data() + half, half, b.data(), 40);
+	REQUIRE(framesA > 0);
+	REQUIRE(framesA == framesB);
+	for (int i = 0; i < framesA * CqtConfig::N_BINS; i++) {
+		REQUIRE(a[i] == b[i]);
+	}
+}
+
+TEST_CASE("StreamingCqtExtractor snapshot rejects method mismatch", "[snapshot][cqt]") {
+	StreamingCqtExtractor original(CqtMethod::Resonator);
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	StreamingCqtExtractor other(CqtMethod::TimeDomain);
+	StateReader r(blob.data(), blob.size());
+	REQUIRE_FALSE(other.loadState(r));
+}
+
+TEST_CASE("ActivationBuffer snapshot preserves BPM estimate", "[snapshot][bpm]") {
+	ActivationBuffer original;
+
+	// 120 BPM beat pattern at 50 FPS: a pulse every 25 frames
+	for (int i = 0; i < 500; i++) {
+		float beat = (i % 25 == 0) ? 0.9f : 0.05f;
+		original.push(beat, (i % 100 == 0) ? 0.8f : 0.02f);
+	}
+
+	std::vector<uint8_t> blob;
+	StateWriter w(blob);
+	original.saveState(w);
+
+	ActivationBuffer restored;
+	StateReader r(blob.data(), blob.size());
+	REQUIRE(restored.loadState(r));
+	REQUIRE(r.atEnd());
+
+	REQUIRE(restored.size() == original.size());
+	REQUIRE(restored.getCachedBpm() == original.getCachedBpm());
+	REQUIRE(restored.estimateCombBpm() == Approx(original.estimateCombBpm()));
+	REQUIRE(restored.estimateBpm() == Approx(original.estimateBpm()));
+}
+
+TEST_CASE("Engine snapshot round-trip", "[snapshot][engine]") {
+	Engine original;
+	auto input = makeSine(3 * 44100, 440.0f, 44100.0f);
+	original.processAudio(input.data(), static_cast<int>(input.size()), nullptr, 0);
+
+	std::vector<uint8_t> blob;
+	original.serialize(blob);
+	REQUIRE(blob.size() > 0);
+
+	SECTION("restores onto a same-configuration engine") {
+		Engine restored;
+		REQUIRE(restored.restore(blob.data(), blob.size()));
+		REQUIRE(restored.getKeyFrameCount() == original.getKeyFrameCount());
+		REQUIRE(restored.getBpm() == original.getBpm());
+
+		// Both engines must continue producing frames on the same schedule
+		auto more = makeSine(44100, 440.0f, 44100.0f);
+		original.processAudio(more.data(), static_cast<int>(more.size()), nullptr, 0);
+		restored.processAudio(more.data(), static_cast<int>(more.size()), nullptr, 0);
+		REQUIRE(restored.getKeyFrameCount() == original.getKeyFrameCount());
+		REQUIRE(restored.getFrameCount() == original.getFrameCount());
+	}
+
+	SECTION("rejects a truncated blob") {
+		Engine restored;
+		REQUIRE_FALSE(restored.restore(blob.data(), blob.size() / 2));
+		REQUIRE(restored.getKeyFrameCount() == 0);
+	}
+
+	SECTION("rejects an input rate mismatch") {
+		Engine restored;
+		REQUIRE(restored.setInputSampleRate(48000));
+		REQUIRE_FALSE(restored.restore(blob.data(), blob.size()));
+	}
+}
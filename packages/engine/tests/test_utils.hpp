@@ -1,5 +1,7 @@
 #pragma once
 
+#include "WavReader.hpp"
+
 #include <vector>
 #include <string>
 #include <cmath>
@@ -33,6 +35,26 @@ inline std::string getModelPath() {
     return getModelsDir() + "beatnet.onnx";
 }
 
+inline std::string getTestDataDir() {
+    return getTestDir() + "../test-data/";
+}
+
+/**
+ * Load a mono WAV file into a float vector (via the mmap reader)
+ */
+inline std::vector<float> loadWav(const std::string& path, int* sampleRate = nullptr) {
+    engine::WavReader reader;
+    if (!reader.open(path)) {
+        return {};
+    }
+    if (sampleRate) {
+        *sampleRate = reader.sampleRate();
+    }
+    std::vector<float> samples(reader.frameCount());
+    reader.read(0, samples.data(), samples.size());
+    return samples;
+}
+
 /**
  * Generate a sine wave for testing
  */
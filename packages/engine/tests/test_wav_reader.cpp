@@ -0,0 +1,108 @@
+/**
+ * WavReader unit tests
+ *
+ * Validates the mmap-based reader against the real 16-bit PCM corpus in
+ * test-data/ and a synthesized float WAV for the zero-copy path.
+ */
+
+#include "catch_amalgamated.hpp"
+#include "WavReader.hpp"
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace engine;
+
+TEST_CASE("WavReader parses 16-bit PCM test data", "[wav]") {
+	WavReader reader;
+	REQUIRE(reader.open(test_utils::getTestDataDir() + "116.wav"));
+
+	REQUIRE(reader.sampleRate() == 22050);
+	REQUIRE(reader.bitsPerSample() == 16);
+	REQUIRE_FALSE(reader.isFloat());
+	REQUIRE(reader.samples() == nullptr);  // Zero-copy span is float-only
+	REQUIRE(reader.frameCount() > 22050);  // More than a second of audio
+
+	SECTION("converted samples are normalized audio") {
+		std::vector<float> samples(reader.frameCount());
+		REQUIRE(reader.read(0, samples.data(), samples.size()) == samples.size());
+
+		float peak = 0.0f;
+		for (float s : samples) {
+			REQUIRE(s >= -1.0f);
+			REQUIRE(s <= 1.0f);
+			peak = std::max(peak, std::fabs(s));
+		}
+		REQUIRE(peak > 0.1f);  // Real music, not silence
+	}
+
+	SECTION("chunked reads match a whole-file read") {
+		std::vector<float> whole(reader.frameCount());
+		reader.read(0, whole.data(), whole.size());
+
+		std::vector<float> chunk(882);
+		size_t offset = 0;
+		while (size_t got = reader.read(offset, chunk.data(), chunk.size())) {
+			REQUIRE(std::memcmp(chunk.data(), whole.data() + offset,
+			                    got * sizeof(float)) == 0);
+			offset += got;
+		}
+		REQUIRE(offset == whole.size());
+	}
+}
+
+TEST_CASE("WavReader exposes float files zero-copy", "[wav]") {
+	// Synthesize a minimal canonical float WAV
+	const std::string path = "/tmp/wav_reader_float_test.wav";
+	auto samples = test_utils::generateSineWave(440.0f, 44100.0f, 4410);
+	{
+		FILE* file = std::fopen(path.c_str(), "wb");
+		REQUIRE(file != nullptr);
+		const uint32_t dataBytes = static_cast<uint32_t>(samples.size() * 4);
+		const uint32_t riffBytes = 36 + dataBytes;
+		const uint32_t fmtSize = 16, rate = 44100, byteRate = rate * 4;
+		const uint16_t format = 3, channels = 1, blockAlign = 4, bits = 32;
+		std::fwrite("RIFF", 1, 4, file);
+		std::fwrite(&riffBytes, 4, 1, file);
+		std::fwrite("WAVEfmt ", 1, 8, file);
+		std::fwrite(&fmtSize, 4, 1, file);
+		std::fwrite(&format, 2, 1, file);
+		std::fwrite(&channels, 2, 1, file);
+		std::fwrite(&rate, 4, 1, file);
+		std::fwrite(&byteRate, 4, 1, file);
+		std::fwrite(&blockAlign, 2, 1, file);
+		std::fwrite(&bits, 2, 1, file);
+		std::fwrite("data", 1, 4, file);
+		std::fwrite(&dataBytes, 4, 1, file);
+		std::fwrite(samples.data(), 4, samples.size(), file);
+		std::fclose(file);
+	}
+
+	WavReader reader;
+	REQUIRE(reader.open(path));
+	REQUIRE(reader.isFloat());
+	REQUIRE(reader.sampleRate() == 44100);
+	REQUIRE(reader.frameCount() == samples.size());
+
+	const float* span = reader.samples();
+	REQUIRE(span != nullptr);
+	REQUIRE(std::memcmp(span, samples.data(), samples.size() * sizeof(float)) == 0);
+
+	reader.close();
+	std::remove(path.c_str());
+}
+
+TEST_CASE("WavReader rejects unsupported input", "[wav]") {
+	WavReader reader;
+
+	SECTION("missing file") {
+		REQUIRE_FALSE(reader.open("/nonexistent/file.wav"));
+		REQUIRE_FALSE(reader.isOpen());
+	}
+
+	SECTION("non-WAV file") {
+		REQUIRE_FALSE(reader.open(test_utils::getTestDataDir() + "127_2A.aiff"));
+	}
+}